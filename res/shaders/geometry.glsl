@@ -4,7 +4,7 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 tangent;
+layout (location = 3) in vec4 tangent; // w = bitangent sign for packed vertices, 1.0 otherwise
 layout (location = 4) in vec3 bitangent;
 layout (location = 5) in ivec4 boneIds; 
 layout (location = 6) in vec4 weights;
@@ -40,10 +40,12 @@ const int MAX_BONE_INFLUENCE = 4;
 layout(std430, binding = 9) buffer FinalBoneMatrices  { mat4 boneMatrices[];    };
 layout(std430, binding = 10) buffer ModelIsAnimated   { int modelIsAnimated[];  };
 layout(std430, binding = 13) readonly buffer InstanceTransforms { mat4 instanceTransforms[]; };
+layout(std430, binding = 15) readonly buffer InstancePalettes { uint instancePalettes[]; };
+layout(std430, binding = 14) readonly buffer DrawToCommand { uint drawToCommand[]; };
 
 void main()
 {
-  vs_out.DrawID = gl_DrawID;
+  vs_out.DrawID = drawToCommand[gl_DrawID];
   int transformIndex = meshToTransform[vs_out.DrawID];
   bool isAnimated = (modelIsAnimated[transformIndex] == 1);
   mat4 modelMat = instanceTransforms[gl_BaseInstance + gl_InstanceID];
@@ -51,7 +53,7 @@ void main()
 
   if (isAnimated)
   {
-    int boneBaseIndex = transformIndex * MAX_BONES;
+    int boneBaseIndex = int(instancePalettes[gl_BaseInstance + gl_InstanceID]) * MAX_BONES;
     mat4 accumulatedSkin = mat4(0.0);
     float accumulatedWeight = 0.0;
 
@@ -74,11 +76,11 @@ void main()
   mat3 normalTransform = transpose(inverse(linearTransform));
 
   vec3 N = normalize(normalTransform * aNormal);
-  vec3 transformedTangent = linearTransform * tangent;
+  vec3 transformedTangent = linearTransform * tangent.xyz;
   vec3 T = length(transformedTangent) > 0.00001
     ? normalize(transformedTangent - N * dot(N, transformedTangent))
     : normalize(abs(N.y) < 0.999 ? cross(vec3(0.0, 1.0, 0.0), N) : cross(vec3(1.0, 0.0, 0.0), N));
-  float handedness = dot(cross(aNormal, tangent), bitangent) < 0.0 ? -1.0 : 1.0;
+  float handedness = tangent.w < 0.0 || dot(cross(aNormal, tangent.xyz), bitangent) < 0.0 ? -1.0 : 1.0;
   vec3 B = normalize(cross(N, T)) * handedness;
 
   vs_out.FragPos = worldPos.xyz;
@@ -146,8 +148,10 @@ void main()
   vec3 normal;
   if (normalMapFlags[fs_in.DrawID] == 1)
   {
-    vec3 tangentNormal = texture(material.normalMap, fs_in.TexCoords).rgb;
-    tangentNormal = tangentNormal * 2.0 - 1.0; // Remap from [0,1] to [-1,1]
+    // Normal maps may be BC5 (XY only), so Z is always rebuilt from XY.
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(material.normalMap, fs_in.TexCoords).rg * 2.0 - 1.0; // Remap from [0,1] to [-1,1]
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
     normal = normalize(fs_in.TBN * tangentNormal);
   }
   else
@@ -24,6 +24,7 @@ const int MAX_BONE_INFLUENCE = 4;
 layout(std430, binding = 9) buffer FinalBoneMatrices { mat4 boneMatrices[]; };
 layout(std430, binding = 10) buffer ModelIsAnimated  { int modelIsAnimated[]; };
 layout(std430, binding = 13) readonly buffer InstanceTransforms { mat4 instanceTransforms[]; };
+layout(std430, binding = 15) readonly buffer InstancePalettes { uint instancePalettes[]; };
 
 void main()
 {
@@ -33,7 +34,7 @@ void main()
 
   if (isAnimated)
   {
-    int boneBaseIndex = transformIndex * MAX_BONES;
+    int boneBaseIndex = int(instancePalettes[gl_BaseInstance + gl_InstanceID]) * MAX_BONES;
     vec4 totalPosition = vec4(0.0f);
     float totalWeight = 0.0f;
     for (int i = 0; i < MAX_BONE_INFLUENCE; i++)
@@ -0,0 +1,512 @@
+#include "AnimationSampler.h"
+#include "ModelManager.h"
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_decompose.hpp>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANIMATION_SAMPLER_SSE 1
+#else
+#define ANIMATION_SAMPLER_SSE 0
+#endif
+
+namespace
+{
+  constexpr size_t LANES = 4;
+
+#if ANIMATION_SAMPLER_SSE
+  struct Lane
+  {
+    __m128 v;
+  };
+
+  inline Lane Load(const float* p) { return { _mm_load_ps(p) }; }
+  inline void Store(float* p, Lane a) { _mm_store_ps(p, a.v); }
+  inline Lane Splat(float f) { return { _mm_set1_ps(f) }; }
+  inline Lane operator+(Lane a, Lane b) { return { _mm_add_ps(a.v, b.v) }; }
+  inline Lane operator-(Lane a, Lane b) { return { _mm_sub_ps(a.v, b.v) }; }
+  inline Lane operator*(Lane a, Lane b) { return { _mm_mul_ps(a.v, b.v) }; }
+  inline Lane operator/(Lane a, Lane b) { return { _mm_div_ps(a.v, b.v) }; }
+  inline Lane Sqrt(Lane a) { return { _mm_sqrt_ps(a.v) }; }
+
+  // Negates the lanes of `a` where `sign` is negative.
+  inline Lane NegateWhereNegative(Lane a, Lane sign)
+  {
+    const __m128 mask = _mm_and_ps(_mm_cmplt_ps(sign.v, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+    return { _mm_xor_ps(a.v, mask) };
+  }
+#else
+  struct Lane
+  {
+    float v[LANES];
+  };
+
+  template<typename Op>
+  inline Lane Apply(Lane a, Lane b, Op op)
+  {
+    Lane r;
+    for (size_t i = 0; i < LANES; ++i) r.v[i] = op(a.v[i], b.v[i]);
+    return r;
+  }
+
+  inline Lane Load(const float* p) { Lane r; for (size_t i = 0; i < LANES; ++i) r.v[i] = p[i]; return r; }
+  inline void Store(float* p, Lane a) { for (size_t i = 0; i < LANES; ++i) p[i] = a.v[i]; }
+  inline Lane Splat(float f) { Lane r; for (float& v : r.v) v = f; return r; }
+  inline Lane operator+(Lane a, Lane b) { return Apply(a, b, [](float x, float y) { return x + y; }); }
+  inline Lane operator-(Lane a, Lane b) { return Apply(a, b, [](float x, float y) { return x - y; }); }
+  inline Lane operator*(Lane a, Lane b) { return Apply(a, b, [](float x, float y) { return x * y; }); }
+  inline Lane operator/(Lane a, Lane b) { return Apply(a, b, [](float x, float y) { return x / y; }); }
+  inline Lane Sqrt(Lane a) { for (float& v : a.v) v = std::sqrt(v); return a; }
+
+  inline Lane NegateWhereNegative(Lane a, Lane sign)
+  {
+    return Apply(a, sign, [](float x, float s) { return s < 0.0f ? -x : x; });
+  }
+#endif
+
+  inline Lane Lerp(Lane from, Lane to, Lane t) { return from + (to - from) * t; }
+
+  // One channel of up to four tracks, both bracketing keys per lane.
+  template<size_t Components>
+  struct ChannelLanes
+  {
+    alignas(16) float from[Components][LANES];
+    alignas(16) float to[Components][LANES];
+    alignas(16) float factor[LANES];
+  };
+
+  constexpr float QUANTIZED_STEPS = 65535.0f;
+  // Every component but the largest of a unit quaternion is within +-1/sqrt(2).
+  constexpr float SMALLEST_THREE_RANGE = 0.70710678f;
+  constexpr float SMALLEST_THREE_STEPS = 32767.0f;
+
+  PackedVec3 EncodeVec3(const glm::vec3& value, const glm::vec3& minimum, const glm::vec3& extent)
+  {
+    const auto quantize = [](float v, float low, float size) {
+      return size > 0.0f
+        ? static_cast<uint16_t>(std::lround(std::clamp((v - low) / size, 0.0f, 1.0f) * QUANTIZED_STEPS))
+        : uint16_t(0);
+    };
+    return { quantize(value.x, minimum.x, extent.x), quantize(value.y, minimum.y, extent.y),
+      quantize(value.z, minimum.z, extent.z) };
+  }
+
+  inline glm::vec3 DecodeVec3(const PackedVec3& packed, const AnimationTracks::QuantizedRange& range)
+  {
+    return range.minimum + range.extent * (glm::vec3(packed.x, packed.y, packed.z) * (1.0f / QUANTIZED_STEPS));
+  }
+
+  PackedQuat EncodeQuat(glm::quat rotation)
+  {
+    rotation = glm::normalize(rotation);
+    int largest = 0;
+    for (int i = 1; i < 4; ++i)
+    {
+      if (std::abs(rotation[i]) > std::abs(rotation[largest]))
+        largest = i;
+    }
+    if (rotation[largest] < 0.0f)
+      rotation = -rotation;
+
+    uint64_t bits = static_cast<uint64_t>(largest) << 45;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i)
+    {
+      if (i == largest)
+        continue;
+      const float normalized = std::clamp(rotation[i] / SMALLEST_THREE_RANGE * 0.5f + 0.5f, 0.0f, 1.0f);
+      bits |= static_cast<uint64_t>(std::lround(normalized * SMALLEST_THREE_STEPS)) << shift;
+      shift -= 15;
+    }
+    return { { static_cast<uint16_t>(bits >> 32), static_cast<uint16_t>(bits >> 16), static_cast<uint16_t>(bits) } };
+  }
+
+  inline glm::quat DecodeQuat(const PackedQuat& packed)
+  {
+    const uint64_t bits = (static_cast<uint64_t>(packed.data[0]) << 32) |
+                          (static_cast<uint64_t>(packed.data[1]) << 16) | packed.data[2];
+    const int largest = static_cast<int>(bits >> 45) & 3;
+
+    glm::quat rotation;
+    float sum = 0.0f;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i)
+    {
+      if (i == largest)
+        continue;
+      const float normalized = static_cast<float>((bits >> shift) & 0x7FFF) / SMALLEST_THREE_STEPS;
+      rotation[i] = (normalized * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+      sum += rotation[i] * rotation[i];
+      shift -= 15;
+    }
+    rotation[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+    return rotation;
+  }
+
+  inline glm::quat Nlerp(const glm::quat& from, const glm::quat& to, float t)
+  {
+    const glm::quat target = glm::dot(from, to) < 0.0f ? -to : to;
+    return glm::normalize(from * (1.0f - t) + target * t);
+  }
+
+  // Indices of the keys to keep. Walks forward from the last kept key and
+  // drops a key while interpolating between that key and the next one still
+  // reproduces every key in between within `tolerance`. A track that ends
+  // up as two equal keys keeps one.
+  template<typename Value, typename Interpolate, typename Error>
+  std::vector<size_t> ReduceKeys(const std::vector<float>& times, const std::vector<Value>& values, float tolerance,
+    Interpolate&& interpolate, Error&& error)
+  {
+    const size_t count = times.size();
+    std::vector<size_t> kept;
+    if (count == 0)
+      return kept;
+
+    kept.push_back(0);
+    for (size_t i = 1; i + 1 < count; ++i)
+    {
+      const size_t from = kept.back();
+      const size_t to = i + 1;
+      const float span = times[to] - times[from];
+
+      bool reproducible = true;
+      for (size_t k = from + 1; k <= i && reproducible; ++k)
+      {
+        const float t = span > std::numeric_limits<float>::epsilon() ? (times[k] - times[from]) / span : 0.0f;
+        reproducible = error(interpolate(values[from], values[to], t), values[k]) <= tolerance;
+      }
+      if (!reproducible)
+        kept.push_back(i);
+    }
+
+    if (count > 1)
+      kept.push_back(count - 1);
+    if (kept.size() == 2 && error(values[kept[0]], values[kept[1]]) <= tolerance)
+      kept.pop_back();
+    return kept;
+  }
+
+  template<typename Key, typename Value, typename Get>
+  void CollectKeys(const std::vector<Key>& keys, const Value& bindValue, std::vector<float>& times,
+    std::vector<Value>& values, Get&& get)
+  {
+    times.clear();
+    values.clear();
+    if (keys.empty())
+    {
+      times.push_back(0.0f);
+      values.push_back(bindValue);
+      return;
+    }
+
+    for (const Key& key : keys)
+    {
+      times.push_back(key.timeStamp);
+      values.push_back(get(key));
+    }
+  }
+
+  void AppendVec3Track(const std::vector<float>& times, const std::vector<glm::vec3>& values, float tolerance,
+    std::vector<AnimationTracks::QuantizedRange>& ranges, std::vector<float>& outTimes, std::vector<PackedVec3>& outValues)
+  {
+    const std::vector<size_t> kept = ReduceKeys(times, values, tolerance,
+      [](const glm::vec3& a, const glm::vec3& b, float t) { return glm::mix(a, b, t); },
+      [](const glm::vec3& a, const glm::vec3& b) { return glm::distance(a, b); });
+
+    glm::vec3 minimum(std::numeric_limits<float>::max());
+    glm::vec3 maximum(std::numeric_limits<float>::lowest());
+    for (const size_t k : kept)
+    {
+      minimum = glm::min(minimum, values[k]);
+      maximum = glm::max(maximum, values[k]);
+    }
+
+    AnimationTracks::QuantizedRange range;
+    range.first = static_cast<uint32_t>(outTimes.size());
+    range.count = static_cast<uint32_t>(kept.size());
+    range.minimum = minimum;
+    range.extent = maximum - minimum;
+    ranges.push_back(range);
+
+    for (const size_t k : kept)
+    {
+      outTimes.push_back(times[k]);
+      outValues.push_back(EncodeVec3(values[k], range.minimum, range.extent));
+    }
+  }
+
+  void AppendRotationTrack(const std::vector<float>& times, const std::vector<glm::quat>& values, float tolerance,
+    std::vector<AnimationTracks::Range>& ranges, std::vector<float>& outTimes, std::vector<PackedQuat>& outValues)
+  {
+    const std::vector<size_t> kept = ReduceKeys(times, values, tolerance, Nlerp,
+      [](const glm::quat& a, const glm::quat& b) {
+        return 2.0f * std::acos(std::min(1.0f, std::abs(glm::dot(a, b))));
+      });
+
+    ranges.push_back({ static_cast<uint32_t>(outTimes.size()), static_cast<uint32_t>(kept.size()) });
+    for (const size_t k : kept)
+    {
+      outTimes.push_back(times[k]);
+      outValues.push_back(EncodeQuat(values[k]));
+    }
+  }
+
+  template<size_t Components, typename Packed, typename Decode>
+  void Gather(const AnimationTracks::Range& range, const std::vector<float>& times, const std::vector<Packed>& values,
+    Decode&& decode, float time, int32_t& cursor, ChannelLanes<Components>& lanes, size_t lane)
+  {
+    const float* keyTimes = times.data() + range.first;
+    const int count = static_cast<int>(range.count);
+    const int key = FindKeyIndex(count, time, cursor, [keyTimes](int i) { return keyTimes[i]; });
+    const int next = std::min(key + 1, count - 1);
+
+    const auto from = decode(values[range.first + key]);
+    const auto to = decode(values[range.first + next]);
+    for (size_t c = 0; c < Components; ++c)
+    {
+      lanes.from[c][lane] = from[static_cast<int>(c)];
+      lanes.to[c][lane] = to[static_cast<int>(c)];
+    }
+
+    const float span = keyTimes[next] - keyTimes[key];
+    lanes.factor[lane] = std::abs(span) <= std::numeric_limits<float>::epsilon()
+      ? 0.0f
+      : std::clamp((time - keyTimes[key]) / span, 0.0f, 1.0f);
+  }
+}
+
+glm::mat4 AffineTransform::ToMat4() const
+{
+  return glm::mat4(
+    rows[0].x, rows[1].x, rows[2].x, 0.0f,
+    rows[0].y, rows[1].y, rows[2].y, 0.0f,
+    rows[0].z, rows[1].z, rows[2].z, 0.0f,
+    rows[0].w, rows[1].w, rows[2].w, 1.0f);
+}
+
+glm::mat4 TransformTRS::ToMat4() const
+{
+  glm::mat4 matrix = glm::mat3_cast(rotation);
+  matrix[0] *= scale.x;
+  matrix[1] *= scale.y;
+  matrix[2] *= scale.z;
+  matrix[3] = glm::vec4(translation, 1.0f);
+  return matrix;
+}
+
+TransformTRS TransformTRS::FromMat4(const glm::mat4& matrix)
+{
+  TransformTRS transform;
+  glm::vec3 skew(0.0f);
+  glm::vec4 perspective(0.0f);
+  if (!glm::decompose(matrix, transform.scale, transform.rotation, transform.translation, skew, perspective))
+    return {};
+  transform.rotation = glm::normalize(transform.rotation);
+  return transform;
+}
+
+TransformTRS TransformTRS::Blend(const TransformTRS& from, const TransformTRS& to, float factor)
+{
+  const float t = glm::clamp(factor, 0.0f, 1.0f);
+  return { glm::mix(from.translation, to.translation, t), Nlerp(from.rotation, to.rotation, t),
+    glm::mix(from.scale, to.scale, t) };
+}
+
+size_t AnimationTracks::GetSize() const
+{
+  return positionRanges.size() * sizeof(QuantizedRange) + rotationRanges.size() * sizeof(Range) +
+    scaleRanges.size() * sizeof(QuantizedRange) + GetKeyCount() * sizeof(float) +
+    positions.size() * sizeof(PackedVec3) + rotations.size() * sizeof(PackedQuat) + scales.size() * sizeof(PackedVec3);
+}
+
+AnimationTracks AnimationSampler::Build(const std::vector<const Bone*>& bones, const std::vector<TransformTRS>& bindPoses)
+{
+  AnimationTracks tracks;
+  tracks.positionRanges.reserve(bones.size());
+  tracks.rotationRanges.reserve(bones.size());
+  tracks.scaleRanges.reserve(bones.size());
+
+  std::vector<float> times;
+  std::vector<glm::vec3> vectors;
+  std::vector<glm::quat> quaternions;
+
+  for (size_t i = 0; i < bones.size(); ++i)
+  {
+    const TransformTRS bindPose = i < bindPoses.size() ? bindPoses[i] : TransformTRS{};
+    const glm::vec3& bindTranslation = bindPose.translation;
+    const glm::quat& bindRotation = bindPose.rotation;
+    const glm::vec3& bindScale = bindPose.scale;
+
+    const Bone& bone = *bones[i];
+    tracks.sourceKeys += bone.GetPositionKeys().size() + bone.GetRotationKeys().size() + bone.GetScaleKeys().size();
+    tracks.sourceSize += bone.GetPositionKeys().size() * sizeof(KeyPosition) +
+      bone.GetRotationKeys().size() * sizeof(KeyRotation) + bone.GetScaleKeys().size() * sizeof(KeyScale);
+
+    // Translation error is relative to the bone's length, or to its range
+    // of motion for bones sitting on their parent's origin.
+    CollectKeys(bone.GetPositionKeys(), bindTranslation, times, vectors,
+      [](const KeyPosition& key) { return key.position; });
+    float boneLength = glm::length(bindTranslation);
+    for (const glm::vec3& position : vectors)
+      boneLength = std::max(boneLength, glm::distance(position, vectors.front()));
+    AppendVec3Track(times, vectors, ANIMATION_POSITION_TOLERANCE * boneLength, tracks.positionRanges,
+      tracks.positionTimes, tracks.positions);
+
+    CollectKeys(bone.GetRotationKeys(), glm::normalize(bindRotation), times, quaternions,
+      [](const KeyRotation& key) { return glm::normalize(key.orientation); });
+    AppendRotationTrack(times, quaternions, ANIMATION_ROTATION_TOLERANCE, tracks.rotationRanges,
+      tracks.rotationTimes, tracks.rotations);
+
+    CollectKeys(bone.GetScaleKeys(), bindScale, times, vectors,
+      [](const KeyScale& key) { return key.scale; });
+    AppendVec3Track(times, vectors, ANIMATION_SCALE_TOLERANCE, tracks.scaleRanges,
+      tracks.scaleTimes, tracks.scales);
+  }
+
+  return tracks;
+}
+
+namespace
+{
+  // Interpolated channels of up to four tracks; the rotation is normalized.
+  struct SampledLanes
+  {
+    Lane tx, ty, tz;
+    Lane qx, qy, qz, qw;
+    Lane sx, sy, sz;
+  };
+
+  // Gathers and interpolates the first `count` tracks four at a time and
+  // hands each group to `emit(base, lanes)`.
+  template<typename Emit>
+  void SampleLanes(const AnimationTracks& tracks, float time, std::vector<int32_t>& cursors, size_t count, Emit&& emit)
+  {
+    for (size_t base = 0; base < count; base += LANES)
+    {
+      ChannelLanes<3> position;
+      ChannelLanes<4> rotation;
+      ChannelLanes<3> scale;
+
+      // Lanes past the last track repeat it; their results are dropped.
+      for (size_t lane = 0; lane < LANES; ++lane)
+      {
+        const size_t track = std::min(base + lane, count - 1);
+        int32_t* cursor = &cursors[track * 3];
+        const AnimationTracks::QuantizedRange& positionRange = tracks.positionRanges[track];
+        const AnimationTracks::QuantizedRange& scaleRange = tracks.scaleRanges[track];
+        Gather(positionRange, tracks.positionTimes, tracks.positions,
+          [&positionRange](const PackedVec3& packed) { return DecodeVec3(packed, positionRange); },
+          time, cursor[0], position, lane);
+        Gather(tracks.rotationRanges[track], tracks.rotationTimes, tracks.rotations, DecodeQuat,
+          time, cursor[1], rotation, lane);
+        Gather(scaleRange, tracks.scaleTimes, tracks.scales,
+          [&scaleRange](const PackedVec3& packed) { return DecodeVec3(packed, scaleRange); },
+          time, cursor[2], scale, lane);
+      }
+
+      SampledLanes lanes;
+      const Lane pt = Load(position.factor);
+      lanes.tx = Lerp(Load(position.from[0]), Load(position.to[0]), pt);
+      lanes.ty = Lerp(Load(position.from[1]), Load(position.to[1]), pt);
+      lanes.tz = Lerp(Load(position.from[2]), Load(position.to[2]), pt);
+
+      const Lane st = Load(scale.factor);
+      lanes.sx = Lerp(Load(scale.from[0]), Load(scale.to[0]), st);
+      lanes.sy = Lerp(Load(scale.from[1]), Load(scale.to[1]), st);
+      lanes.sz = Lerp(Load(scale.from[2]), Load(scale.to[2]), st);
+
+      // nlerp along the shorter arc. glm::quat indexes as x, y, z, w.
+      const Lane ax = Load(rotation.from[0]), ay = Load(rotation.from[1]);
+      const Lane az = Load(rotation.from[2]), aw = Load(rotation.from[3]);
+      Lane bx = Load(rotation.to[0]), by = Load(rotation.to[1]);
+      Lane bz = Load(rotation.to[2]), bw = Load(rotation.to[3]);
+      const Lane cosine = ax * bx + ay * by + az * bz + aw * bw;
+      bx = NegateWhereNegative(bx, cosine);
+      by = NegateWhereNegative(by, cosine);
+      bz = NegateWhereNegative(bz, cosine);
+      bw = NegateWhereNegative(bw, cosine);
+
+      const Lane rt = Load(rotation.factor);
+      const Lane qx = Lerp(ax, bx, rt), qy = Lerp(ay, by, rt), qz = Lerp(az, bz, rt), qw = Lerp(aw, bw, rt);
+      const Lane inverseLength = Splat(1.0f) / Sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+      lanes.qx = qx * inverseLength;
+      lanes.qy = qy * inverseLength;
+      lanes.qz = qz * inverseLength;
+      lanes.qw = qw * inverseLength;
+
+      emit(base, lanes);
+    }
+  }
+}
+
+void AnimationSampler::Sample(const AnimationTracks& tracks, float time, std::vector<int32_t>& cursors,
+  std::vector<AffineTransform>& out, size_t trackCount)
+{
+  cursors.resize(tracks.GetTrackCount() * 3, 0);
+  out.resize(tracks.GetTrackCount());
+  const size_t count = std::min(trackCount, tracks.GetTrackCount());
+  if (count == 0)
+    return;
+
+  SampleLanes(tracks, time, cursors, count, [&out, count](size_t base, const SampledLanes& lanes)
+  {
+    // translation * rotation * scale, row by row.
+    const Lane qx = lanes.qx, qy = lanes.qy, qz = lanes.qz, qw = lanes.qw;
+    const Lane one = Splat(1.0f), two = Splat(2.0f);
+    const Lane xx = qx * qx, yy = qy * qy, zz = qz * qz;
+    const Lane xy = qx * qy, xz = qx * qz, yz = qy * qz;
+    const Lane wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+    alignas(16) float rows[12][LANES];
+    Store(rows[0], (one - two * (yy + zz)) * lanes.sx);
+    Store(rows[1], two * (xy - wz) * lanes.sy);
+    Store(rows[2], two * (xz + wy) * lanes.sz);
+    Store(rows[3], lanes.tx);
+    Store(rows[4], two * (xy + wz) * lanes.sx);
+    Store(rows[5], (one - two * (xx + zz)) * lanes.sy);
+    Store(rows[6], two * (yz - wx) * lanes.sz);
+    Store(rows[7], lanes.ty);
+    Store(rows[8], two * (xz - wy) * lanes.sx);
+    Store(rows[9], two * (yz + wx) * lanes.sy);
+    Store(rows[10], (one - two * (xx + yy)) * lanes.sz);
+    Store(rows[11], lanes.tz);
+
+    for (size_t lane = 0; lane < LANES && base + lane < count; ++lane)
+    {
+      AffineTransform& transform = out[base + lane];
+      for (int row = 0; row < 3; ++row)
+        transform.rows[row] = glm::vec4(rows[row * 4][lane], rows[row * 4 + 1][lane],
+          rows[row * 4 + 2][lane], rows[row * 4 + 3][lane]);
+    }
+  });
+}
+
+void AnimationSampler::Sample(const AnimationTracks& tracks, float time, std::vector<int32_t>& cursors,
+  std::vector<TransformTRS>& out, size_t trackCount)
+{
+  cursors.resize(tracks.GetTrackCount() * 3, 0);
+  out.resize(tracks.GetTrackCount());
+  const size_t count = std::min(trackCount, tracks.GetTrackCount());
+  if (count == 0)
+    return;
+
+  SampleLanes(tracks, time, cursors, count, [&out, count](size_t base, const SampledLanes& lanes)
+  {
+    alignas(16) float channels[10][LANES];
+    const Lane* sources[10] = { &lanes.tx, &lanes.ty, &lanes.tz, &lanes.qx, &lanes.qy, &lanes.qz, &lanes.qw,
+      &lanes.sx, &lanes.sy, &lanes.sz };
+    for (int c = 0; c < 10; ++c)
+      Store(channels[c], *sources[c]);
+
+    for (size_t lane = 0; lane < LANES && base + lane < count; ++lane)
+    {
+      TransformTRS& transform = out[base + lane];
+      transform.translation = glm::vec3(channels[0][lane], channels[1][lane], channels[2][lane]);
+      transform.rotation = glm::quat(channels[6][lane], channels[3][lane], channels[4][lane], channels[5][lane]);
+      transform.scale = glm::vec3(channels[7][lane], channels[8][lane], channels[9][lane]);
+    }
+  });
+}
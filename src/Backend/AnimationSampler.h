@@ -0,0 +1,141 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+struct Bone;
+
+// Index i of the key pair [i, i + 1] bracketing `time` among `count`
+// ascending key times (`timeAt(i)`), same result as a linear scan from key
+// 0. `cursor` is the index found last time: playback only ever moves forward
+// by a key or two, so that index and the next ones are tried first, and
+// seeks, loops and blends fall back to a binary search.
+template<typename TimeAt>
+int FindKeyIndex(int count, float time, int& cursor, TimeAt&& timeAt)
+{
+  const int last = count - 2;
+  if (last <= 0)
+    return 0;
+
+  const auto brackets = [&](int i) {
+    return (i == 0 || time >= timeAt(i)) && (i == last || time < timeAt(i + 1));
+  };
+
+  const int start = std::clamp(cursor, 0, last);
+  for (int i = start; i <= std::min(start + 2, last); ++i)
+  {
+    if (brackets(i))
+      return cursor = i;
+  }
+
+  // First key after `time` among keys 1..count-1.
+  int low = 1;
+  int high = count;
+  while (low < high)
+  {
+    const int middle = (low + high) / 2;
+    if (time < timeAt(middle))
+      high = middle;
+    else
+      low = middle + 1;
+  }
+  return cursor = std::min(low - 1, last);
+}
+
+// Affine transform as three rows; the fourth row is implicitly 0 0 0 1.
+struct AffineTransform
+{
+  glm::vec4 rows[3];
+
+  glm::mat4 ToMat4() const;
+};
+
+// Local transform kept as translation, rotation and scale, so poses can be
+// blended channel by channel without decomposing matrices.
+struct TransformTRS
+{
+  glm::vec3 translation = glm::vec3(0.0f);
+  glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+  glm::vec3 scale = glm::vec3(1.0f);
+
+  glm::mat4 ToMat4() const;
+  // Identity when `matrix` has no such decomposition.
+  static TransformTRS FromMat4(const glm::mat4& matrix);
+  // lerp for translation and scale, nlerp along the shorter arc for rotation.
+  static TransformTRS Blend(const TransformTRS& from, const TransformTRS& to, float factor);
+};
+
+// 48-bit smallest-three rotation: the index of the largest component in the
+// top two bits, the other three at 15 bits each. The largest component is
+// made positive and rebuilt from the unit length.
+struct PackedQuat
+{
+  uint16_t data[3];
+};
+
+// Position or scale quantized to 16 bits per axis over its track's range.
+struct PackedVec3
+{
+  uint16_t x, y, z;
+};
+
+// Keyframes of one clip as structure of arrays, key-reduced and quantized.
+// Per channel, the key times and values of all tracks are stored back to
+// back, and a range per track says where its keys are, so the key search
+// only reads times. A channel without keys holds a single key with the bind
+// pose value.
+struct AnimationTracks
+{
+  struct Range
+  {
+    uint32_t first = 0;
+    uint32_t count = 0;
+  };
+
+  // value = minimum + extent * packed / 65535
+  struct QuantizedRange : Range
+  {
+    glm::vec3 minimum = glm::vec3(0.0f);
+    glm::vec3 extent = glm::vec3(0.0f);
+  };
+
+  std::vector<QuantizedRange> positionRanges;
+  std::vector<Range> rotationRanges;
+  std::vector<QuantizedRange> scaleRanges;
+  std::vector<float> positionTimes;
+  std::vector<float> rotationTimes;
+  std::vector<float> scaleTimes;
+  std::vector<PackedVec3> positions;
+  std::vector<PackedQuat> rotations;
+  std::vector<PackedVec3> scales;
+
+  size_t sourceKeys = 0; // before key reduction
+  size_t sourceSize = 0; // bytes of the source Bone keys
+
+  inline size_t GetTrackCount() const { return positionRanges.size(); }
+  inline size_t GetKeyCount() const { return positionTimes.size() + rotationTimes.size() + scaleTimes.size(); }
+  size_t GetSize() const;
+};
+
+// Clip sampling kernel. Interpolates four tracks at a time with SSE (scalar
+// lanes elsewhere): lerp for translation and scale, nlerp for rotation, then
+// either composes translation * rotation * scale straight into 3x4 rows or
+// hands the channels out as TransformTRS for blending.
+struct AnimationSampler
+{
+  // One track per bone, in the given order; `bindPoses[i]` is the local
+  // transform of the node bone i animates, used for its channels without
+  // keys and to scale the translation tolerance.
+  static AnimationTracks Build(const std::vector<const Bone*>& bones, const std::vector<TransformTRS>& bindPoses);
+
+  // Samples the first `trackCount` tracks (all by default) at `time` into
+  // `out`, one transform per track; the rest of `out` is left as it was.
+  // `cursors` keeps three playback cursors per track between calls.
+  static void Sample(const AnimationTracks& tracks, float time, std::vector<int32_t>& cursors,
+    std::vector<AffineTransform>& out, size_t trackCount = SIZE_MAX);
+  static void Sample(const AnimationTracks& tracks, float time, std::vector<int32_t>& cursors,
+    std::vector<TransformTRS>& out, size_t trackCount = SIZE_MAX);
+};
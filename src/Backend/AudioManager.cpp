@@ -429,33 +429,38 @@ void AudioManager::SetSoundLoop(const std::string& name, bool loop)
   }
 }
 
-void AudioManager::LoadSound(const char* filename)
+struct DecodedSound
 {
-  std::string name = std::filesystem::path(filename).stem().string();
+  std::string name;
+  std::vector<short> samples;
+  ALenum format = AL_NONE;
+  int sampleRate = 0;
+};
 
-  {
-      std::lock_guard lock(s_Data.s_AudioMutex);
-      if (s_Data.p_SoundEffectBuffers.contains(name)) {
-          return;
-      }
-  }
+static bool IsSoundLoaded(const std::string& name)
+{
+  std::lock_guard lock(s_Data.s_AudioMutex);
+  return s_Data.p_SoundEffectBuffers.contains(name);
+}
 
-  ALenum format = AL_NONE;
-  ALuint buffer;
+// Pure CPU work (file IO + sndfile decode); safe to run on any thread.
+static bool DecodeSound(const char* filename, DecodedSound& sound)
+{
   SF_INFO sfinfo;
 
   SNDFILE *sndfile = sf_open(filename, SFM_READ, &sfinfo);
   if (!sndfile) {
       std::cerr << "Could not open audio in " << filename << ": " << sf_strerror(sndfile) << "\n";
-      return;
+      return false;
   }
 
   if (sfinfo.frames < 1 || sfinfo.frames > (sf_count_t)(INT_MAX / sizeof(short)) / sfinfo.channels) {
       std::cerr << "Bad sample count in " << filename << " (" << sfinfo.frames << ")\n";
       sf_close(sndfile);
-      return;
+      return false;
   }
 
+  ALenum format = AL_NONE;
   if (sfinfo.channels == 1) format = AL_FORMAT_MONO16;
   else if (sfinfo.channels == 2) format = AL_FORMAT_STEREO16;
   else if (sfinfo.channels == 3 &&
@@ -468,30 +473,33 @@ void AudioManager::LoadSound(const char* filename)
   if (format == AL_NONE) {
       std::cerr << "Unsupported channel count: " << sfinfo.channels << "\n";
       sf_close(sndfile);
-      return;
+      return false;
   }
 
-  short *membuf = static_cast<short *>(malloc(static_cast<size_t>(sfinfo.frames * sfinfo.channels) * sizeof(short)));
-  if (!membuf) {
-      std::cerr << "Failed to allocate memory for audio buffer\n";
-      sf_close(sndfile);
-      return;
-  }
+  sound.samples.resize(static_cast<size_t>(sfinfo.frames * sfinfo.channels));
 
-  sf_count_t num_frames = sf_readf_short(sndfile, membuf, sfinfo.frames);
+  sf_count_t num_frames = sf_readf_short(sndfile, sound.samples.data(), sfinfo.frames);
+  sf_close(sndfile);
   if (num_frames < 1) {
       std::cerr << "Failed to read samples in " << filename << " (" << num_frames << ")\n";
-      free(membuf);
-      sf_close(sndfile);
-      return;
+      return false;
   }
 
-  ALsizei num_bytes = static_cast<ALsizei>(num_frames * sfinfo.channels * sizeof(short));
-  alGenBuffers(1, &buffer);
-  alBufferData(buffer, format, membuf, num_bytes, sfinfo.samplerate);
+  sound.samples.resize(static_cast<size_t>(num_frames * sfinfo.channels));
+  sound.format = format;
+  sound.sampleRate = sfinfo.samplerate;
+  return true;
+}
 
-  free(membuf);
-  sf_close(sndfile);
+static void UploadSound(const DecodedSound& sound)
+{
+  if (IsSoundLoaded(sound.name))
+      return;
+
+  ALuint buffer;
+  ALsizei num_bytes = static_cast<ALsizei>(sound.samples.size() * sizeof(short));
+  alGenBuffers(1, &buffer);
+  alBufferData(buffer, sound.format, sound.samples.data(), num_bytes, sound.sampleRate);
 
   if (ALenum err = alGetError(); err != AL_NO_ERROR) {
       std::cerr << "OpenAL Error: " << alGetString(err) << "\n";
@@ -502,9 +510,34 @@ void AudioManager::LoadSound(const char* filename)
 
   {
       std::lock_guard lock(s_Data.s_AudioMutex);
-      s_Data.p_SoundEffectBuffers[name] = buffer;
+      s_Data.p_SoundEffectBuffers[sound.name] = buffer;
   }
-  GABGL_WARN("Sound loaded: {0}",name);
+  GABGL_WARN("Sound loaded: {0}",sound.name);
+}
+
+void AudioManager::LoadSound(const char* filename)
+{
+  DecodedSound sound;
+  sound.name = std::filesystem::path(filename).stem().string();
+  if (IsSoundLoaded(sound.name))
+      return;
+
+  if (DecodeSound(filename, sound))
+      UploadSound(sound);
+}
+
+JobHandle AudioManager::LoadSoundAsync(const std::string& filename)
+{
+  auto sound = std::make_shared<DecodedSound>();
+  sound->name = std::filesystem::path(filename).stem().string();
+  if (IsSoundLoaded(sound->name))
+      return nullptr;
+
+  auto decoded = std::make_shared<bool>(false);
+  return JobSystem::Submit(
+    [filename, sound, decoded]() { *decoded = DecodeSound(filename.c_str(), *sound); },
+    [sound, decoded]() { if (*decoded) UploadSound(*sound); },
+    JobPriority::LOW);
 }
 
 bool AudioManager::UnLoadSound(const std::string& name)
@@ -4,6 +4,7 @@
 #include <al.h>
 #include <glm/glm.hpp>
 #include <string>
+#include "JobSystem.h"
 
 struct AudioManager
 {
@@ -24,6 +25,8 @@ struct AudioManager
 
   // SOUND
   static void LoadSound(const char* filename);
+  // Decodes on the job system; the AL buffer is created on the main thread.
+  static JobHandle LoadSoundAsync(const std::string& filename);
   static bool UnLoadSound(const std::string& name);
   static void PlaySound(const std::string& name, const float& volume = 1.0f);
   static void PlaySound(const std::string& name, const glm::vec3& position, const float& volume = 1.0f);
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Flat little-endian blob writer/reader used by the on-disk asset caches.
+// Only trivially copyable types are written directly; everything else is
+// serialized field by field by the caller.
+
+struct BinaryWriter
+{
+  template<typename T>
+  void Write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  void WriteBytes(const void* data, size_t size)
+  {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+  }
+
+  void WriteString(const std::string& value)
+  {
+    Write(static_cast<uint32_t>(value.size()));
+    WriteBytes(value.data(), value.size());
+  }
+
+  template<typename T>
+  void WriteVector(const std::vector<T>& values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    Write(static_cast<uint64_t>(values.size()));
+    WriteBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  // Writes to a temporary file first so a crash mid-write never leaves a
+  // truncated cache entry behind.
+  bool SaveToFile(const std::filesystem::path& path) const
+  {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::filesystem::path tmp = path;
+    tmp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      if (!out)
+        return false;
+      out.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()));
+      if (!out)
+        return false;
+    }
+
+    std::filesystem::rename(tmp, path, ec);
+    if (ec)
+    {
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+    return true;
+  }
+
+  inline size_t GetSize() const { return m_Buffer.size(); }
+  inline const std::vector<uint8_t>& GetBuffer() const { return m_Buffer; }
+
+private:
+  std::vector<uint8_t> m_Buffer;
+};
+
+struct BinaryReader
+{
+  BinaryReader(const uint8_t* data, size_t size) : m_Data(data), m_Size(size) {}
+
+  template<typename T>
+  bool Read(T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return ReadBytes(&value, sizeof(T));
+  }
+
+  bool ReadBytes(void* dest, size_t size)
+  {
+    if (m_Failed || size > m_Size - m_Offset)
+    {
+      m_Failed = true;
+      return false;
+    }
+    std::memcpy(dest, m_Data + m_Offset, size);
+    m_Offset += size;
+    return true;
+  }
+
+  bool ReadString(std::string& value)
+  {
+    uint32_t size = 0;
+    if (!Read(size) || size > m_Size - m_Offset)
+    {
+      m_Failed = true;
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(m_Data + m_Offset), size);
+    m_Offset += size;
+    return true;
+  }
+
+  template<typename T>
+  bool ReadVector(std::vector<T>& values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    uint64_t count = 0;
+    if (!Read(count) || count > (m_Size - m_Offset) / sizeof(T))
+    {
+      m_Failed = true;
+      return false;
+    }
+    values.resize(static_cast<size_t>(count));
+    return ReadBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  // Returns a view into the underlying buffer without copying.
+  const uint8_t* Peek(size_t size)
+  {
+    if (m_Failed || size > m_Size - m_Offset)
+    {
+      m_Failed = true;
+      return nullptr;
+    }
+    const uint8_t* ptr = m_Data + m_Offset;
+    m_Offset += size;
+    return ptr;
+  }
+
+  inline bool IsValid() const { return !m_Failed; }
+  inline bool IsAtEnd() const { return m_Offset == m_Size; }
+  inline size_t GetRemaining() const { return m_Size - m_Offset; }
+
+private:
+  const uint8_t* m_Data = nullptr;
+  size_t m_Size = 0;
+  size_t m_Offset = 0;
+  bool m_Failed = false;
+};
@@ -7,6 +7,8 @@
 #include <numbers>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <deque>
 #include <glad/glad.h>
 #include "Window.h"
 
@@ -40,7 +42,7 @@ void VertexBuffer::Unbind() const
 
 void VertexBuffer::SetData(const void* data, uint32_t size)
 {
-  glNamedBufferSubData(m_RendererID, 0, size, data);
+  StagingRing::UploadBuffer(m_RendererID, 0, data, size);
 }
 
 IndexBuffer::IndexBuffer(uint32_t* indices, uint32_t count) : m_Count(count)
@@ -237,15 +239,14 @@ void StorageBuffer::SetData(size_t size, const void* data)
       Allocate(size);
   }
 
-  // Update buffer data (you could use glMapBufferRange for performance gains with large data)
-  if (data != nullptr) glNamedBufferSubData(m_RendererID, 0, (GLsizeiptr)size, data); 
+  if (data != nullptr) StagingRing::UploadBuffer(m_RendererID, 0, data, size);
 }
 
 void StorageBuffer::SetSubData(GLintptr offset, GLsizeiptr size, const void* data)
 {
-  if (m_RendererID != 0 && data != nullptr)
+  if (m_RendererID != 0 && data != nullptr && size > 0)
   {
-      glNamedBufferSubData(m_RendererID, offset, size, data);
+      StagingRing::UploadBuffer(m_RendererID, static_cast<size_t>(offset), data, static_cast<size_t>(size));
   }
 }
 
@@ -259,61 +260,212 @@ void StorageBuffer::UnmapBuffer()
   if (m_RendererID != 0) glUnmapNamedBuffer(m_RendererID);
 }
 
-PixelBuffer::PixelBuffer(size_t size) : m_Size(size)
+namespace
 {
-  glCreateBuffers(1, &m_ID);
-  glNamedBufferData(m_ID, m_Size, nullptr, GL_STREAM_DRAW); 
+  struct StagingRegion
+  {
+    size_t Begin = 0;
+    size_t End = 0;
+    GLsync Sync = nullptr;
+  };
+
+  struct StagingRingData
+  {
+    GLuint ID = 0;
+    uint8_t* Mapped = nullptr;
+    size_t Capacity = 0;
+    size_t Head = 0;
+    size_t PendingBegin = 0;
+    std::deque<StagingRegion> InFlight;
+
+    size_t FrameBytes = 0;
+    uint32_t FrameUploads = 0;
+    uint32_t FrameStalls = 0;
+    StagingRing::Stats Stats;
+  };
+
+  StagingRingData s_Staging;
+
+  void WaitForRegion(const StagingRegion& region)
+  {
+    GLenum result = glClientWaitSync(region.Sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+      ++s_Staging.FrameStalls;
+      while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(region.Sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000); // 1ms
+    }
+    glDeleteSync(region.Sync);
+  }
 }
 
-PixelBuffer::~PixelBuffer()
+void StagingRing::Init(size_t capacity)
 {
-  if (m_ID) glDeleteBuffers(1, &m_ID);
-  if (m_Sync)
+  Shutdown();
+
+  constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glCreateBuffers(1, &s_Staging.ID);
+  glNamedBufferStorage(s_Staging.ID, (GLsizeiptr)capacity, nullptr, flags);
+  s_Staging.Mapped = static_cast<uint8_t*>(glMapNamedBufferRange(s_Staging.ID, 0, (GLsizeiptr)capacity, flags));
+  if (!s_Staging.Mapped)
   {
-      glDeleteSync(m_Sync);
-      m_Sync = nullptr;
+    GABGL_ERROR("Failed to map the staging ring, uploads fall back to direct copies");
+    glDeleteBuffers(1, &s_Staging.ID);
+    s_Staging.ID = 0;
+    return;
   }
+
+  s_Staging.Capacity = capacity;
+  s_Staging.Stats.Capacity = capacity;
 }
 
-void* PixelBuffer::Map()
+void StagingRing::Shutdown()
 {
-  return glMapNamedBufferRange(m_ID, 0, m_Size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+  for (const StagingRegion& region : s_Staging.InFlight)
+    glDeleteSync(region.Sync);
+
+  if (s_Staging.ID)
+  {
+    glUnmapNamedBuffer(s_Staging.ID);
+    glDeleteBuffers(1, &s_Staging.ID);
+  }
+  s_Staging = {};
 }
 
-void PixelBuffer::Unmap()
+StagingRing::Allocation StagingRing::Allocate(size_t size, size_t alignment)
 {
-  glUnmapNamedBuffer(m_ID);
+  if (!s_Staging.Mapped || size == 0 || size > s_Staging.Capacity)
+    return {};
+
+  size_t offset = (s_Staging.Head + alignment - 1) / alignment * alignment;
+  if (offset + size > s_Staging.Capacity)
+  {
+    // Keep the pending range contiguous before wrapping to the start.
+    Fence();
+    offset = 0;
+    s_Staging.PendingBegin = 0;
+  }
 
-  // Insert fence after unmap for sync (same behavior)
-  if (m_Sync)
-      glDeleteSync(m_Sync);
-  m_Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  // Regions retire in allocation order, which is also the order the head
+  // runs into them, so only the oldest ones can overlap the new range.
+  while (!s_Staging.InFlight.empty())
+  {
+    const StagingRegion& oldest = s_Staging.InFlight.front();
+    if (oldest.End <= offset || oldest.Begin >= offset + size)
+      break;
+    WaitForRegion(oldest);
+    s_Staging.InFlight.pop_front();
+  }
+
+  s_Staging.Head = offset + size;
+  s_Staging.FrameBytes += size;
+  ++s_Staging.FrameUploads;
+  return { s_Staging.Mapped + offset, offset, size };
 }
 
-void PixelBuffer::WaitForCompletion()
+void StagingRing::Fence()
 {
-  if (m_Sync)
+  if (!s_Staging.Mapped || s_Staging.Head == s_Staging.PendingBegin)
+    return;
+
+  s_Staging.InFlight.push_back({ s_Staging.PendingBegin, s_Staging.Head, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) });
+  s_Staging.PendingBegin = s_Staging.Head;
+}
+
+void StagingRing::EndFrame()
+{
+  Fence();
+
+  while (!s_Staging.InFlight.empty())
+  {
+    const StagingRegion& oldest = s_Staging.InFlight.front();
+    if (glClientWaitSync(oldest.Sync, 0, 0) == GL_TIMEOUT_EXPIRED)
+      break;
+    glDeleteSync(oldest.Sync);
+    s_Staging.InFlight.pop_front();
+  }
+
+  s_Staging.Stats.BytesLastFrame = s_Staging.FrameBytes;
+  s_Staging.Stats.UploadsLastFrame = s_Staging.FrameUploads;
+  s_Staging.Stats.StallsLastFrame = s_Staging.FrameStalls;
+  s_Staging.FrameBytes = 0;
+  s_Staging.FrameUploads = 0;
+  s_Staging.FrameStalls = 0;
+}
+
+void StagingRing::UploadBuffer(GLuint buffer, size_t offset, const void* data, size_t size)
+{
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  // Large uploads go through in half-ring chunks so the copy of one chunk
+  // overlaps the memcpy of the next.
+  const size_t chunkSize = std::max<size_t>(s_Staging.Capacity / 2, 1);
+
+  while (size > 0)
   {
-    GLenum result = glClientWaitSync(m_Sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000); // 1ms
-    if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+    const size_t chunk = std::min(size, chunkSize);
+    const Allocation staging = Allocate(chunk);
+    if (!staging.IsValid())
     {
-        glWaitSync(m_Sync, 0, GL_TIMEOUT_IGNORED); // Block until finished
+      glNamedBufferSubData(buffer, (GLintptr)offset, (GLsizeiptr)size, bytes);
+      return;
     }
-    glDeleteSync(m_Sync);
-    m_Sync = nullptr;
+
+    std::memcpy(staging.Data, bytes, chunk);
+    glCopyNamedBufferSubData(s_Staging.ID, buffer, (GLintptr)staging.Offset, (GLintptr)offset, (GLsizeiptr)chunk);
+
+    bytes += chunk;
+    offset += chunk;
+    size -= chunk;
+    if (size > 0)
+      Fence();
   }
 }
 
-void PixelBuffer::Bind() const
+void StagingRing::UploadTexture2D(GLuint texture, GLint level, GLsizei width, GLsizei height,
+  GLenum format, GLenum type, const void* data, size_t size)
 {
-  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_ID); 
+  const Allocation staging = Allocate(size, 4);
+  if (!staging.IsValid())
+  {
+    glTextureSubImage2D(texture, level, 0, 0, width, height, format, type, data);
+    return;
+  }
+
+  std::memcpy(staging.Data, data, size);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_Staging.ID);
+  glTextureSubImage2D(texture, level, 0, 0, width, height, format, type, reinterpret_cast<const void*>(staging.Offset));
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
-void PixelBuffer::Unbind() const
+void StagingRing::UploadCompressedTexture2D(GLuint texture, GLint level, GLsizei width, GLsizei height,
+  GLenum internalFormat, const void* data, size_t size)
 {
+  const Allocation staging = Allocate(size, 16);
+  if (!staging.IsValid())
+  {
+    glCompressedTextureSubImage2D(texture, level, 0, 0, width, height, internalFormat, (GLsizei)size, data);
+    return;
+  }
+
+  std::memcpy(staging.Data, data, size);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_Staging.ID);
+  glCompressedTextureSubImage2D(texture, level, 0, 0, width, height, internalFormat, (GLsizei)size,
+    reinterpret_cast<const void*>(staging.Offset));
   glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
+GLuint StagingRing::GetID()
+{
+  return s_Staging.ID;
+}
+
+StagingRing::Stats StagingRing::GetStats()
+{
+  Stats stats = s_Staging.Stats;
+  stats.BytesThisFrame = s_Staging.FrameBytes;
+  return stats;
+}
+
 static const uint32_t s_MaxFramebufferSize = 8192;
 
 namespace Utils
@@ -193,27 +193,52 @@ private:
   size_t bufferSize = 0;
 };
 
-struct PixelBuffer
+// One persistently mapped, coherent upload buffer that texture, vertex and
+// storage buffer uploads all sub-allocate from. Allocations are carved
+// linearly and wrap around; each batch is fenced, and a region is only
+// handed out again once its fence has signalled, so an upload only waits
+// when the ring laps the GPU.
+struct StagingRing
 {
-  explicit PixelBuffer(size_t size);
-  ~PixelBuffer();
-
-  void* Map();
-  void Unmap();
-  void Bind() const;
-  void Unbind() const;
-  void WaitForCompletion();
+  struct Allocation
+  {
+    void* Data = nullptr;
+    size_t Offset = 0;
+    size_t Size = 0;
 
-  GLuint GetID() const { return m_ID; }
-  size_t GetSize() const { return m_Size; }
+    inline bool IsValid() const { return Data != nullptr; }
+  };
 
-private:
-  PixelBuffer(const PixelBuffer&) = delete;
-  PixelBuffer& operator=(const PixelBuffer&) = delete;
+  struct Stats
+  {
+    size_t Capacity = 0;
+    size_t BytesThisFrame = 0;
+    size_t BytesLastFrame = 0;
+    uint32_t UploadsLastFrame = 0;
+    uint32_t StallsLastFrame = 0;
+  };
 
-  GLuint m_ID = 0;
-  size_t m_Size = 0;
-  GLsync m_Sync = nullptr;
+  static void Init(size_t capacity);
+  static void Shutdown();
+
+  // Invalid when the ring is not initialized or `size` exceeds it.
+  static Allocation Allocate(size_t size, size_t alignment = 16);
+  // Fences every allocation made since the previous call.
+  static void Fence();
+  // Fences the frame's uploads, retires signalled regions and rolls the
+  // per-frame counters.
+  static void EndFrame();
+
+  // Copy helpers; they go through the ring and fall back to a direct upload
+  // when it is unavailable or too small for the data.
+  static void UploadBuffer(GLuint buffer, size_t offset, const void* data, size_t size);
+  static void UploadTexture2D(GLuint texture, GLint level, GLsizei width, GLsizei height,
+    GLenum format, GLenum type, const void* data, size_t size);
+  static void UploadCompressedTexture2D(GLuint texture, GLint level, GLsizei width, GLsizei height,
+    GLenum internalFormat, const void* data, size_t size);
+
+  static GLuint GetID();
+  static Stats GetStats();
 };
 
 enum class FramebufferTextureFormat
@@ -0,0 +1,459 @@
+#include "JobSystem.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+static constexpr size_t JOB_PRIORITY_COUNT = 3;
+
+struct JobState
+{
+  std::function<void()> task;
+  std::function<void()> mainThreadCompletion;
+  JobPriority priority = JobPriority::NORMAL;
+
+  // Starts at 1 so the job cannot be scheduled while Submit is still
+  // registering it with its dependencies.
+  std::atomic<uint32_t> pendingDependencies = 1;
+  std::atomic<bool> complete = false;
+
+  std::mutex continuationMutex;
+  std::vector<JobHandle> continuations;
+};
+
+struct WorkerQueue
+{
+  std::mutex mutex;
+  std::array<std::deque<JobHandle>, JOB_PRIORITY_COUNT> jobs;
+};
+
+struct WorkerCounters
+{
+  std::atomic<uint64_t> jobsExecuted = 0;
+  std::atomic<uint64_t> jobsStolen = 0;
+  std::atomic<uint64_t> busyNanos = 0;
+  std::atomic<uint64_t> idleNanos = 0;
+};
+
+struct JobSystemData
+{
+  std::vector<std::thread> workers;
+  // One queue per worker plus a trailing injection queue for jobs submitted
+  // from threads outside the pool.
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::vector<std::unique_ptr<WorkerCounters>> counters;
+
+  std::atomic<bool> running = false;
+  std::atomic<uint32_t> queuedJobs = 0;
+  std::mutex sleepMutex;
+  std::condition_variable sleepCondition;
+
+  std::mutex completionMutex;
+  std::condition_variable completionCondition;
+
+  std::mutex mainThreadMutex;
+  std::vector<std::function<void()>> mainThreadQueue;
+  std::thread::id mainThreadId;
+
+  uint32_t workerCount = 0;
+} s_Data;
+
+static thread_local int32_t t_WorkerIndex = -1;
+
+static uint64_t NowNanos()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static size_t InjectionQueueIndex()
+{
+  return s_Data.workerCount;
+}
+
+static void Schedule(const JobHandle& job)
+{
+  const size_t queueIndex = t_WorkerIndex >= 0 ? static_cast<size_t>(t_WorkerIndex) : InjectionQueueIndex();
+  {
+    WorkerQueue& queue = *s_Data.queues[queueIndex];
+    std::lock_guard lock(queue.mutex);
+    queue.jobs[static_cast<size_t>(job->priority)].push_back(job);
+  }
+  s_Data.queuedJobs.fetch_add(1, std::memory_order_release);
+
+  // Taking the lock orders this notify after a worker's predicate check.
+  { std::lock_guard lock(s_Data.sleepMutex); }
+  s_Data.sleepCondition.notify_one();
+}
+
+static void Finish(const JobHandle& job)
+{
+  std::vector<JobHandle> continuations;
+  {
+    std::lock_guard lock(job->continuationMutex);
+    job->complete.store(true, std::memory_order_release);
+    continuations.swap(job->continuations);
+  }
+
+  job->task = nullptr;
+  job->mainThreadCompletion = nullptr;
+
+  for (const JobHandle& continuation : continuations)
+    if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      Schedule(continuation);
+
+  { std::lock_guard lock(s_Data.completionMutex); }
+  s_Data.completionCondition.notify_all();
+}
+
+static void Execute(const JobHandle& job, size_t counterIndex, bool stolen)
+{
+  const uint64_t start = NowNanos();
+  try
+  {
+    if (job->task) job->task();
+  }
+  catch (const std::exception& e)
+  {
+    GABGL_ERROR("[JOBSYSTEM]: Job threw: {}", e.what());
+  }
+  catch (...)
+  {
+    GABGL_ERROR("[JOBSYSTEM]: Job threw an unknown exception");
+  }
+
+  WorkerCounters& counters = *s_Data.counters[counterIndex];
+  counters.busyNanos.fetch_add(NowNanos() - start, std::memory_order_relaxed);
+  counters.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+  if (stolen) counters.jobsStolen.fetch_add(1, std::memory_order_relaxed);
+
+  if (job->mainThreadCompletion)
+  {
+    std::lock_guard lock(s_Data.mainThreadMutex);
+    s_Data.mainThreadQueue.emplace_back([job]()
+    {
+      job->mainThreadCompletion();
+      Finish(job);
+    });
+    return;
+  }
+
+  Finish(job);
+}
+
+static JobHandle PopFrom(size_t queueIndex, size_t priority, bool back)
+{
+  WorkerQueue& queue = *s_Data.queues[queueIndex];
+  std::lock_guard lock(queue.mutex);
+  auto& jobs = queue.jobs[priority];
+  if (jobs.empty())
+    return nullptr;
+
+  JobHandle job;
+  if (back)
+  {
+    job = std::move(jobs.back());
+    jobs.pop_back();
+  }
+  else
+  {
+    job = std::move(jobs.front());
+    jobs.pop_front();
+  }
+  return job;
+}
+
+// Priority dominates locality: a HIGH job anywhere wins over a NORMAL job in
+// the caller's own deque.
+static bool TryRunOne()
+{
+  if (s_Data.queuedJobs.load(std::memory_order_acquire) == 0)
+    return false;
+
+  const int32_t self = t_WorkerIndex;
+  const size_t counterIndex = self >= 0 ? static_cast<size_t>(self) : InjectionQueueIndex();
+  const size_t queueCount = s_Data.queues.size();
+
+  for (size_t priority = 0; priority < JOB_PRIORITY_COUNT; ++priority)
+  {
+    bool stolen = false;
+    JobHandle job;
+
+    if (self >= 0)
+      job = PopFrom(static_cast<size_t>(self), priority, true);
+    if (!job)
+      job = PopFrom(InjectionQueueIndex(), priority, false);
+    if (!job)
+    {
+      const size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+      for (size_t i = 0; i < s_Data.workerCount && !job; ++i)
+      {
+        const size_t victim = (start + i) % s_Data.workerCount;
+        if (static_cast<int32_t>(victim) == self || victim >= queueCount)
+          continue;
+        job = PopFrom(victim, priority, false);
+        stolen = job != nullptr;
+      }
+    }
+
+    if (job)
+    {
+      s_Data.queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+      Execute(job, counterIndex, stolen);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void WorkerLoop(uint32_t index)
+{
+  t_WorkerIndex = static_cast<int32_t>(index);
+  WorkerCounters& counters = *s_Data.counters[index];
+
+  while (s_Data.running.load(std::memory_order_acquire))
+  {
+    if (TryRunOne())
+      continue;
+
+    const uint64_t idleStart = NowNanos();
+    {
+      std::unique_lock lock(s_Data.sleepMutex);
+      s_Data.sleepCondition.wait(lock, []()
+      {
+        return !s_Data.running.load(std::memory_order_acquire) ||
+               s_Data.queuedJobs.load(std::memory_order_acquire) > 0;
+      });
+    }
+    counters.idleNanos.fetch_add(NowNanos() - idleStart, std::memory_order_relaxed);
+  }
+}
+
+void JobSystem::Init(uint32_t workerCount)
+{
+  if (s_Data.running)
+    return;
+
+  if (workerCount == 0)
+  {
+    // hardware_concurrency() may report 0 when it cannot tell.
+    const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  s_Data.workerCount = workerCount;
+  s_Data.mainThreadId = std::this_thread::get_id();
+  s_Data.queues.clear();
+  s_Data.counters.clear();
+  for (uint32_t i = 0; i <= workerCount; ++i)
+  {
+    s_Data.queues.emplace_back(std::make_unique<WorkerQueue>());
+    s_Data.counters.emplace_back(std::make_unique<WorkerCounters>());
+  }
+
+  s_Data.running = true;
+  for (uint32_t i = 0; i < workerCount; ++i)
+    s_Data.workers.emplace_back(WorkerLoop, i);
+
+  GABGL_INFO("[JOBSYSTEM]: Started {} workers", workerCount);
+}
+
+void JobSystem::Shutdown()
+{
+  if (!s_Data.running)
+    return;
+
+  {
+    std::lock_guard lock(s_Data.sleepMutex);
+    s_Data.running = false;
+  }
+  s_Data.sleepCondition.notify_all();
+
+  for (std::thread& worker : s_Data.workers)
+    if (worker.joinable()) worker.join();
+
+  s_Data.workers.clear();
+  s_Data.queues.clear();
+  s_Data.counters.clear();
+  s_Data.queuedJobs = 0;
+  s_Data.workerCount = 0;
+
+  std::lock_guard lock(s_Data.mainThreadMutex);
+  s_Data.mainThreadQueue.clear();
+}
+
+JobHandle JobSystem::Submit(std::function<void()> job, JobPriority priority, const std::vector<JobHandle>& dependencies)
+{
+  return Submit(std::move(job), nullptr, priority, dependencies);
+}
+
+JobHandle JobSystem::Submit(std::function<void()> job, std::function<void()> onMainThread, JobPriority priority,
+  const std::vector<JobHandle>& dependencies)
+{
+  auto state = std::make_shared<JobState>();
+  state->task = std::move(job);
+  state->mainThreadCompletion = std::move(onMainThread);
+  state->priority = priority;
+
+  if (!s_Data.running)
+  {
+    // Pool not started (tools, early init): degrade to inline execution.
+    for (const JobHandle& dependency : dependencies)
+      Wait(dependency);
+    if (state->task) state->task();
+    if (state->mainThreadCompletion) state->mainThreadCompletion();
+    Finish(state);
+    return state;
+  }
+
+  for (const JobHandle& dependency : dependencies)
+  {
+    if (!dependency)
+      continue;
+    std::lock_guard lock(dependency->continuationMutex);
+    if (dependency->complete.load(std::memory_order_acquire))
+      continue;
+    state->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+    dependency->continuations.push_back(state);
+  }
+
+  if (state->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    Schedule(state);
+
+  return state;
+}
+
+void JobSystem::RunOnMainThread(std::function<void()> task)
+{
+  if (IsMainThread())
+  {
+    task();
+    return;
+  }
+
+  std::lock_guard lock(s_Data.mainThreadMutex);
+  s_Data.mainThreadQueue.emplace_back(std::move(task));
+}
+
+void JobSystem::ProcessMainThreadQueue()
+{
+  std::vector<std::function<void()>> tasks;
+  {
+    std::lock_guard lock(s_Data.mainThreadMutex);
+    tasks.swap(s_Data.mainThreadQueue);
+  }
+
+  for (auto& task : tasks)
+    task();
+}
+
+bool JobSystem::IsComplete(const JobHandle& handle)
+{
+  return !handle || handle->complete.load(std::memory_order_acquire);
+}
+
+bool JobSystem::IsComplete(const std::vector<JobHandle>& handles)
+{
+  return std::ranges::all_of(handles, [](const JobHandle& handle) { return IsComplete(handle); });
+}
+
+void JobSystem::Wait(const JobHandle& handle)
+{
+  const bool isMainThread = IsMainThread();
+
+  while (!IsComplete(handle))
+  {
+    if (isMainThread)
+      ProcessMainThreadQueue();
+
+    if (TryRunOne())
+      continue;
+
+    std::unique_lock lock(s_Data.completionMutex);
+    s_Data.completionCondition.wait_for(lock, std::chrono::microseconds(200), [&handle]()
+    {
+      return IsComplete(handle) || s_Data.queuedJobs.load(std::memory_order_acquire) > 0;
+    });
+  }
+}
+
+void JobSystem::Wait(const std::vector<JobHandle>& handles)
+{
+  for (const JobHandle& handle : handles)
+    Wait(handle);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& func,
+  JobPriority priority)
+{
+  if (count == 0)
+    return;
+
+  grainSize = std::max<size_t>(grainSize, 1);
+  const size_t maxChunks = static_cast<size_t>(s_Data.workerCount) + 1;
+  const size_t chunkCount = std::min(maxChunks, (count + grainSize - 1) / grainSize);
+  if (chunkCount <= 1 || !s_Data.running)
+  {
+    func(0, count);
+    return;
+  }
+
+  const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+  std::vector<JobHandle> chunks;
+  chunks.reserve(chunkCount - 1);
+  for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+  {
+    const size_t end = std::min(count, begin + chunkSize);
+    chunks.emplace_back(Submit([&func, begin, end]() { func(begin, end); }, priority));
+  }
+
+  func(0, std::min(count, chunkSize));
+  Wait(chunks);
+}
+
+uint32_t JobSystem::GetWorkerCount()
+{
+  return s_Data.workerCount;
+}
+
+bool JobSystem::IsMainThread()
+{
+  return std::this_thread::get_id() == s_Data.mainThreadId;
+}
+
+std::vector<JobWorkerStats> JobSystem::GetWorkerStats()
+{
+  std::vector<JobWorkerStats> stats;
+  stats.reserve(s_Data.counters.size());
+  for (const auto& counters : s_Data.counters)
+  {
+    JobWorkerStats entry;
+    entry.jobsExecuted = counters->jobsExecuted.load(std::memory_order_relaxed);
+    entry.jobsStolen = counters->jobsStolen.load(std::memory_order_relaxed);
+    entry.busyMillis = static_cast<float>(counters->busyNanos.load(std::memory_order_relaxed)) * 1e-6f;
+    entry.idleMillis = static_cast<float>(counters->idleNanos.load(std::memory_order_relaxed)) * 1e-6f;
+    const float total = entry.busyMillis + entry.idleMillis;
+    entry.utilization = total > 0.0f ? entry.busyMillis / total : 0.0f;
+    stats.push_back(entry);
+  }
+  return stats;
+}
+
+void JobSystem::ResetStats()
+{
+  for (const auto& counters : s_Data.counters)
+  {
+    counters->jobsExecuted = 0;
+    counters->jobsStolen = 0;
+    counters->busyNanos = 0;
+    counters->idleNanos = 0;
+  }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+enum class JobPriority : uint8_t
+{
+  HIGH = 0,
+  NORMAL = 1,
+  LOW = 2
+};
+
+struct JobState;
+using JobHandle = std::shared_ptr<JobState>;
+
+template<typename T>
+struct JobFuture;
+
+struct JobWorkerStats
+{
+  uint64_t jobsExecuted = 0;
+  uint64_t jobsStolen = 0;
+  float busyMillis = 0.0f;
+  float idleMillis = 0.0f;
+  float utilization = 0.0f; // busy / (busy + idle) since the last ResetStats()
+};
+
+// Fixed-size work-stealing thread pool. Every worker owns one deque per
+// priority; owners pop LIFO, thieves and external submitters work FIFO.
+// Jobs may depend on other jobs and may carry a completion that runs on the
+// main thread; a handle only reports complete once that completion has run.
+struct JobSystem
+{
+  static void Init(uint32_t workerCount = 0); // 0 = hardware_concurrency - 1
+  static void Shutdown();
+
+  static JobHandle Submit(std::function<void()> job, JobPriority priority = JobPriority::NORMAL,
+    const std::vector<JobHandle>& dependencies = {});
+  static JobHandle Submit(std::function<void()> job, std::function<void()> onMainThread,
+    JobPriority priority = JobPriority::NORMAL, const std::vector<JobHandle>& dependencies = {});
+
+  // std::async-style helper; the result lives in shared storage so the caller
+  // may drop the future while the job is still running.
+  template<typename F>
+  static JobFuture<std::invoke_result_t<F>> Async(F&& func, JobPriority priority = JobPriority::NORMAL);
+
+  static void RunOnMainThread(std::function<void()> task);
+  static void ProcessMainThreadQueue();
+
+  static bool IsComplete(const JobHandle& handle);
+  static bool IsComplete(const std::vector<JobHandle>& handles);
+  // Runs other jobs (and main-thread completions when called from the main
+  // thread) while waiting, so it is safe to call from inside a job.
+  static void Wait(const JobHandle& handle);
+  static void Wait(const std::vector<JobHandle>& handles);
+
+  // Splits [0, count) into chunks of at least grainSize and blocks until all
+  // of them ran. The calling thread takes part in the work.
+  static void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& func,
+    JobPriority priority = JobPriority::HIGH);
+
+  static uint32_t GetWorkerCount();
+  static bool IsMainThread();
+  // One entry per worker plus a trailing entry for work done by helping threads.
+  static std::vector<JobWorkerStats> GetWorkerStats();
+  static void ResetStats();
+};
+
+template<typename T>
+struct JobFuture
+{
+  JobHandle handle;
+  std::shared_ptr<T> result = std::make_shared<T>();
+
+  inline bool IsReady() const { return JobSystem::IsComplete(handle); }
+  T& Get() { JobSystem::Wait(handle); return *result; }
+};
+
+template<typename F>
+JobFuture<std::invoke_result_t<F>> JobSystem::Async(F&& func, JobPriority priority)
+{
+  JobFuture<std::invoke_result_t<F>> future;
+  future.handle = Submit([result = future.result, func = std::forward<F>(func)]() mutable
+  {
+    *result = func();
+  }, priority);
+  return future;
+}
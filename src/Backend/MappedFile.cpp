@@ -0,0 +1,90 @@
+#include "MappedFile.h"
+#include "Logger.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return;
+  m_File = file;
+
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    Close();
+    return;
+  }
+
+  m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m_Mapping)
+  {
+    Close();
+    return;
+  }
+
+  m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!m_Data)
+  {
+    GABGL_ERROR("[MAPPEDFILE]: MapViewOfFile failed for {}", path.string());
+    Close();
+    return;
+  }
+  m_Size = static_cast<size_t>(size.QuadPart);
+#else
+  m_File = open(path.c_str(), O_RDONLY);
+  if (m_File < 0)
+    return;
+
+  struct stat info{};
+  if (fstat(m_File, &info) != 0 || info.st_size == 0)
+  {
+    Close();
+    return;
+  }
+
+  void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_File, 0);
+  if (data == MAP_FAILED)
+  {
+    GABGL_ERROR("[MAPPEDFILE]: mmap failed for {}", path.string());
+    Close();
+    return;
+  }
+  m_Data = static_cast<const uint8_t*>(data);
+  m_Size = static_cast<size_t>(info.st_size);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+  if (m_Data) UnmapViewOfFile(m_Data);
+  if (m_Mapping) CloseHandle(m_Mapping);
+  if (m_File) CloseHandle(m_File);
+  m_Mapping = nullptr;
+  m_File = nullptr;
+#else
+  if (m_Data) munmap(const_cast<uint8_t*>(m_Data), m_Size);
+  if (m_File >= 0) close(m_File);
+  m_File = -1;
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file. The view stays valid for the
+// lifetime of the object.
+struct MappedFile
+{
+  MappedFile() = default;
+  explicit MappedFile(const std::filesystem::path& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  inline bool IsOpen() const { return m_Data != nullptr; }
+  inline const uint8_t* GetData() const { return m_Data; }
+  inline size_t GetSize() const { return m_Size; }
+
+private:
+  void Close();
+
+  const uint8_t* m_Data = nullptr;
+  size_t m_Size = 0;
+#ifdef _WIN32
+  void* m_File = nullptr;
+  void* m_Mapping = nullptr;
+#else
+  int m_File = -1;
+#endif
+};
@@ -0,0 +1,381 @@
+#include "ModelCache.h"
+#include "ModelManager.h"
+#include "BinaryStream.hpp"
+#include "MappedFile.h"
+#include "SourceStamp.hpp"
+#include "TextureRegistry.h"
+#include "Logger.h"
+#include "Timer.hpp"
+
+#include <filesystem>
+#include <format>
+#include <unordered_map>
+
+namespace
+{
+  constexpr uint32_t MODEL_CACHE_MAGIC = 0x4D424147; // "GABM"
+  constexpr uint32_t MODEL_CACHE_VERSION = 5;
+  constexpr const char* MODEL_CACHE_DIRECTORY = "../res/cache/models";
+
+  enum class CachedTextureSource : uint8_t
+  {
+    FILE = 0,
+    EMBEDDED = 1
+  };
+
+  struct CachedTexture
+  {
+    CachedTextureSource source = CachedTextureSource::FILE;
+    std::string path;
+    std::string type;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const uint8_t* data = nullptr;
+  };
+
+  std::filesystem::path GetCacheFile(const SourceStamp& stamp, float optimizerStrength, bool isAnimated)
+  {
+    const std::string key = std::format("{}|{}|{}", stamp.path, optimizerStrength, isAnimated);
+    const std::string stem = std::filesystem::path(stamp.path).stem().string();
+    return std::filesystem::path(MODEL_CACHE_DIRECTORY) / std::format("{}_{:016x}.gabmodel", stem, std::hash<std::string>{}(key));
+  }
+
+  void WriteHierarchy(BinaryWriter& writer, const AssimpNodeData& node)
+  {
+    writer.WriteString(node.name);
+    writer.Write(node.transformation);
+    writer.Write(static_cast<uint32_t>(node.children.size()));
+    for (const AssimpNodeData& child : node.children)
+      WriteHierarchy(writer, child);
+  }
+
+  bool ReadHierarchy(BinaryReader& reader, AssimpNodeData& node)
+  {
+    uint32_t childCount = 0;
+    if (!reader.ReadString(node.name) || !reader.Read(node.transformation) || !reader.Read(childCount))
+      return false;
+    if (childCount > reader.GetRemaining())
+      return false;
+
+    node.childrenCount = static_cast<int>(childCount);
+    node.children.resize(childCount);
+    for (AssimpNodeData& child : node.children)
+      if (!ReadHierarchy(reader, child))
+        return false;
+    return true;
+  }
+}
+
+bool ModelCache::Load(const std::string& sourcePath, Model& model)
+{
+  Timer timer;
+
+  SourceStamp stamp;
+  if (!SourceStamp::Get(sourcePath, stamp))
+    return false;
+
+  const auto cacheFile = GetCacheFile(stamp, model.m_OptimizerStrength, model.m_isAnimated);
+  std::error_code ec;
+  if (!std::filesystem::exists(cacheFile, ec))
+    return false;
+
+  const MappedFile file(cacheFile);
+  if (!file.IsOpen())
+    return false;
+
+  BinaryReader reader(file.GetData(), file.GetSize());
+
+  uint32_t magic = 0, version = 0;
+  std::string cachedPath;
+  uint64_t cachedSize = 0;
+  int64_t cachedTime = 0;
+  float optimizerStrength = 0.0f;
+  uint8_t isAnimated = 0;
+  reader.Read(magic);
+  reader.Read(version);
+  reader.ReadString(cachedPath);
+  reader.Read(cachedSize);
+  reader.Read(cachedTime);
+  reader.Read(optimizerStrength);
+  reader.Read(isAnimated);
+
+  if (!reader.IsValid() || magic != MODEL_CACHE_MAGIC || version != MODEL_CACHE_VERSION ||
+      cachedPath != stamp.path || cachedSize != stamp.size || cachedTime != stamp.mtime ||
+      optimizerStrength != model.m_OptimizerStrength || (isAnimated != 0) != model.m_isAnimated)
+  {
+    GABGL_TRACE("[MODELCACHE]: Stale entry for {}", sourcePath);
+    return false;
+  }
+
+  uint32_t textureCount = 0;
+  reader.Read(textureCount);
+  if (textureCount > reader.GetRemaining())
+    return false;
+
+  std::vector<CachedTexture> cachedTextures(textureCount);
+  for (CachedTexture& texture : cachedTextures)
+  {
+    reader.Read(texture.source);
+    reader.ReadString(texture.path);
+    reader.ReadString(texture.type);
+    if (texture.source == CachedTextureSource::EMBEDDED)
+    {
+      uint64_t size = 0;
+      reader.Read(texture.width);
+      reader.Read(texture.height);
+      reader.Read(size);
+      texture.data = reader.Peek(size);
+    }
+  }
+
+  uint32_t meshCount = 0;
+  reader.Read(meshCount);
+  if (!reader.IsValid() || meshCount > reader.GetRemaining())
+    return false;
+
+  std::vector<Mesh> meshes(meshCount);
+  std::vector<std::vector<uint32_t>> meshTextures(meshCount);
+  for (uint32_t i = 0; i < meshCount; ++i)
+  {
+    Mesh& mesh = meshes[i];
+    uint8_t hasNormalMap = 0, hasSpecularMap = 0;
+    reader.ReadVector(mesh.m_Vertices);
+    reader.ReadVector(mesh.m_Indices);
+    for (std::vector<GLuint>& lod : mesh.m_LodIndices)
+      reader.ReadVector(lod);
+    reader.ReadVector(mesh.m_Meshlets);
+    reader.ReadVector(meshTextures[i]);
+    reader.Read(hasNormalMap);
+    reader.Read(hasSpecularMap);
+    mesh.hasNormalMap = hasNormalMap != 0;
+    mesh.hasSpecularMap = hasSpecularMap != 0;
+
+    for (uint32_t textureIndex : meshTextures[i])
+      if (textureIndex >= textureCount)
+        return false;
+  }
+
+  glm::vec3 boundsCenter(0.0f);
+  float boundsRadius = 0.0f;
+  glm::mat4 globalInverse(1.0f);
+  int boneCounter = 0;
+  uint32_t boneInfoCount = 0;
+  reader.Read(boundsCenter);
+  reader.Read(boundsRadius);
+  reader.Read(globalInverse);
+  reader.Read(boneCounter);
+  reader.Read(boneInfoCount);
+  if (!reader.IsValid() || boneInfoCount > reader.GetRemaining())
+    return false;
+
+  std::map<std::string, BoneInfo> boneInfoMap;
+  for (uint32_t i = 0; i < boneInfoCount; ++i)
+  {
+    std::string name;
+    BoneInfo info;
+    reader.ReadString(name);
+    reader.Read(info.id);
+    reader.Read(info.offset);
+    boneInfoMap[name] = info;
+  }
+
+  uint32_t animationCount = 0;
+  reader.Read(animationCount);
+  if (!reader.IsValid() || animationCount > reader.GetRemaining())
+    return false;
+
+  std::vector<AnimationData> animations(animationCount);
+  for (AnimationData& animation : animations)
+  {
+    uint32_t boneCount = 0;
+    reader.ReadString(animation.name);
+    reader.Read(animation.duration);
+    reader.Read(animation.ticksPerSecond);
+    reader.Read(boneCount);
+    if (!reader.IsValid() || boneCount > reader.GetRemaining())
+      return false;
+
+    animation.bones.reserve(boneCount);
+    for (uint32_t i = 0; i < boneCount; ++i)
+    {
+      std::string name;
+      int id = -1;
+      std::vector<KeyPosition> positions;
+      std::vector<KeyRotation> rotations;
+      std::vector<KeyScale> scales;
+      reader.ReadString(name);
+      reader.Read(id);
+      reader.ReadVector(positions);
+      reader.ReadVector(rotations);
+      reader.ReadVector(scales);
+      animation.bones.emplace_back(name, id, std::move(positions), std::move(rotations), std::move(scales));
+    }
+  }
+
+  // One node hierarchy for all clips.
+  AssimpNodeData rootNode;
+  if (animationCount > 0 && !ReadHierarchy(reader, rootNode))
+    return false;
+
+  uint32_t endMagic = 0;
+  reader.Read(endMagic);
+  if (!reader.IsValid() || endMagic != MODEL_CACHE_MAGIC || !reader.IsAtEnd())
+  {
+    GABGL_WARN("[MODELCACHE]: Corrupt entry {}", cacheFile.string());
+    return false;
+  }
+
+  // Everything parsed; only now touch the model and decode textures.
+  std::vector<std::shared_ptr<Texture>> textures(textureCount);
+  for (uint32_t i = 0; i < textureCount; ++i)
+  {
+    const CachedTexture& cached = cachedTextures[i];
+    textures[i] = cached.source == CachedTextureSource::EMBEDDED
+      ? TextureRegistry::AcquireEmbedded(cached.data, cached.width, cached.height, cached.path, cached.type)
+      : TextureRegistry::AcquireFile(cached.path, model.m_Directory, cached.type);
+  }
+  Texture::DecodeAll(textures);
+
+  for (uint32_t i = 0; i < meshCount; ++i)
+    for (uint32_t textureIndex : meshTextures[i])
+      meshes[i].m_Textures.emplace_back(textures[textureIndex]);
+
+  model.m_Meshes = std::move(meshes);
+  model.m_BoundsCenter = boundsCenter;
+  model.m_BoundsRadius = boundsRadius;
+  model.m_GlobalInverseTransform = globalInverse;
+  model.m_BoneCounter = boneCounter;
+  model.m_BoneInfoMap = std::move(boneInfoMap);
+  model.m_ProcessedAnimations = std::move(animations);
+  model.m_RootNode = std::move(rootNode);
+
+  GABGL_INFO("[MODELCACHE]: Loaded {} from cache in {} ms", sourcePath, timer.ElapsedMillis());
+  return true;
+}
+
+void ModelCache::Save(const std::string& sourcePath, const Model& model)
+{
+  Timer timer;
+
+  SourceStamp stamp;
+  if (!SourceStamp::Get(sourcePath, stamp))
+    return;
+
+  BinaryWriter writer;
+  writer.Write(MODEL_CACHE_MAGIC);
+  writer.Write(MODEL_CACHE_VERSION);
+  writer.WriteString(stamp.path);
+  writer.Write(stamp.size);
+  writer.Write(stamp.mtime);
+  writer.Write(model.m_OptimizerStrength);
+  writer.Write(static_cast<uint8_t>(model.m_isAnimated));
+
+  // Meshes share Texture instances; keep that sharing through a texture table.
+  std::vector<Texture*> textures;
+  std::unordered_map<const Texture*, uint32_t> textureIndices;
+  for (const Mesh& mesh : model.m_Meshes)
+    for (const auto& texture : mesh.m_Textures)
+      if (texture && textureIndices.try_emplace(texture.get(), static_cast<uint32_t>(textures.size())).second)
+        textures.push_back(texture.get());
+
+  // A registry-shared texture carries the path of whichever model created
+  // it; write the path this model's materials use (its own "*N" index or
+  // file name relative to m_Directory) instead.
+  std::unordered_map<const Texture*, const std::string*> localPaths;
+  for (const auto& [path, texture] : model.m_TexturesLoaded)
+    localPaths.try_emplace(texture.get(), &path);
+
+  writer.Write(static_cast<uint32_t>(textures.size()));
+  for (Texture* texture : textures)
+  {
+    const auto localPath = localPaths.find(texture);
+    if (localPath == localPaths.end())
+    {
+      GABGL_WARN("[MODELCACHE]: Texture {} not loaded by this model, not caching {}", texture->GetPath(), sourcePath);
+      return;
+    }
+    const std::string& path = *localPath->second;
+
+    const bool isEmbedded = !path.empty() && path[0] == '*';
+    const aiTexture* embedded = isEmbedded && model.m_Scene ? model.m_Scene->GetEmbeddedTexture(path.c_str()) : nullptr;
+    if (isEmbedded && (!embedded || !embedded->pcData))
+    {
+      GABGL_WARN("[MODELCACHE]: Embedded texture {} unavailable, not caching {}", path, sourcePath);
+      return;
+    }
+
+    writer.Write(isEmbedded ? CachedTextureSource::EMBEDDED : CachedTextureSource::FILE);
+    writer.WriteString(path);
+    writer.WriteString(texture->GetType());
+    if (isEmbedded)
+    {
+      const uint64_t size = embedded->mHeight == 0
+        ? embedded->mWidth
+        : static_cast<uint64_t>(embedded->mWidth) * embedded->mHeight * 4;
+      writer.Write(embedded->mWidth);
+      writer.Write(embedded->mHeight);
+      writer.Write(size);
+      writer.WriteBytes(embedded->pcData, size);
+    }
+  }
+
+  writer.Write(static_cast<uint32_t>(model.m_Meshes.size()));
+  for (const Mesh& mesh : model.m_Meshes)
+  {
+    std::vector<uint32_t> meshTextures;
+    for (const auto& texture : mesh.m_Textures)
+      if (texture)
+        meshTextures.push_back(textureIndices.at(texture.get()));
+
+    writer.WriteVector(mesh.m_Vertices);
+    writer.WriteVector(mesh.m_Indices);
+    for (const std::vector<GLuint>& lod : mesh.m_LodIndices)
+      writer.WriteVector(lod);
+    writer.WriteVector(mesh.m_Meshlets);
+    writer.WriteVector(meshTextures);
+    writer.Write(static_cast<uint8_t>(mesh.hasNormalMap));
+    writer.Write(static_cast<uint8_t>(mesh.hasSpecularMap));
+  }
+
+  writer.Write(model.m_BoundsCenter);
+  writer.Write(model.m_BoundsRadius);
+  writer.Write(model.m_GlobalInverseTransform);
+  writer.Write(model.m_BoneCounter);
+  writer.Write(static_cast<uint32_t>(model.m_BoneInfoMap.size()));
+  for (const auto& [name, info] : model.m_BoneInfoMap)
+  {
+    writer.WriteString(name);
+    writer.Write(info.id);
+    writer.Write(info.offset);
+  }
+
+  writer.Write(static_cast<uint32_t>(model.m_ProcessedAnimations.size()));
+  for (const AnimationData& animation : model.m_ProcessedAnimations)
+  {
+    writer.WriteString(animation.name);
+    writer.Write(animation.duration);
+    writer.Write(animation.ticksPerSecond);
+    writer.Write(static_cast<uint32_t>(animation.bones.size()));
+    for (const Bone& bone : animation.bones)
+    {
+      writer.WriteString(bone.GetBoneName());
+      writer.Write(bone.GetBoneID());
+      writer.WriteVector(bone.GetPositionKeys());
+      writer.WriteVector(bone.GetRotationKeys());
+      writer.WriteVector(bone.GetScaleKeys());
+    }
+  }
+  if (!model.m_ProcessedAnimations.empty())
+    WriteHierarchy(writer, model.m_RootNode);
+
+  writer.Write(MODEL_CACHE_MAGIC);
+
+  const auto cacheFile = GetCacheFile(stamp, model.m_OptimizerStrength, model.m_isAnimated);
+  if (!writer.SaveToFile(cacheFile))
+  {
+    GABGL_WARN("[MODELCACHE]: Failed to write {}", cacheFile.string());
+    return;
+  }
+
+  GABGL_INFO("[MODELCACHE]: Wrote {} ({} KB) in {} ms", cacheFile.string(), writer.GetSize() / 1024, timer.ElapsedMillis());
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+struct Model;
+
+// Versioned on-disk snapshot of a fully processed Model (post OptimizeMesh
+// vertex/index streams, bones, animations, bounds and texture references).
+// Entries are keyed by source path, source size/mtime, optimizer strength and
+// the animated flag, and are memory-mapped on load.
+struct ModelCache
+{
+  // Fills `model` from the cache. Returns false on a miss or a stale/corrupt
+  // entry, in which case `model` is left untouched.
+  static bool Load(const std::string& sourcePath, Model& model);
+
+  // Must be called while the model's aiScene is still alive so embedded
+  // textures can be copied into the entry, and before m_TexturesLoaded is
+  // cleared, since texture paths are taken from it.
+  static void Save(const std::string& sourcePath, const Model& model);
+};
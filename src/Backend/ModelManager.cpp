@@ -1,16 +1,21 @@
 #include "ModelManager.h"
+#include "ModelCache.h"
+#include "TextureRegistry.h"
+#include "JobSystem.h"
 #include "Logger.h"
 #include "glad/glad.h"
 #include "meshoptimizer.h"
 #include <filesystem>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
-#include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
 #include "Renderer.h"
 #include "Timer.hpp"
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <ranges>
 #include <unordered_set>
 
@@ -35,48 +40,32 @@ static glm::quat AssimpQuatToGLMQuat(const aiQuaternion& pOrientation)
   return {pOrientation.w, pOrientation.x, pOrientation.y, pOrientation.z};
 }
 
-static float WrapAnimationTime(float time, float duration)
-{
-  if (!std::isfinite(time) || !std::isfinite(duration) || duration <= std::numeric_limits<float>::epsilon())
-    return 0.0f;
-
-  const float wrapped = std::fmod(time, duration);
-  return wrapped < 0.0f ? wrapped + duration : wrapped;
-}
-
-static glm::mat4 BlendLocalTransforms(const glm::mat4& from, const glm::mat4& to, float factor)
+static PackedVertex PackVertex(const Vertex& vertex)
 {
-  glm::vec3 fromScale(1.0f);
-  glm::quat fromRotation(1.0f, 0.0f, 0.0f, 0.0f);
-  glm::vec3 fromTranslation(0.0f);
-  glm::vec3 fromSkew(0.0f);
-  glm::vec4 fromPerspective(0.0f);
+  PackedVertex packed{};
+  packed.Position = vertex.Position;
+  packed.Normal = glm::packSnorm3x10_1x2(glm::vec4(vertex.Normal, 0.0f));
 
-  glm::vec3 toScale(1.0f);
-  glm::quat toRotation(1.0f, 0.0f, 0.0f, 0.0f);
-  glm::vec3 toTranslation(0.0f);
-  glm::vec3 toSkew(0.0f);
+  const float handedness = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f ? -1.0f : 1.0f;
+  packed.Tangent = glm::packSnorm3x10_1x2(glm::vec4(vertex.Tangent, handedness));
+  packed.TexCoords = glm::packHalf2x16(vertex.TexCoords);
 
-  if (glm::vec4 toPerspective(0.0f); !glm::decompose(from, fromScale, fromRotation, fromTranslation, fromSkew, fromPerspective) ||
-                                     !glm::decompose(to, toScale, toRotation, toTranslation, toSkew, toPerspective))
+  for (int i = 0; i < MAX_BONE_INFLUENCE; ++i)
   {
-    const float t = glm::clamp(factor, 0.0f, 1.0f);
-    return from * (1.0f - t) + to * t;
+    const bool used = vertex.m_BoneIDs[i] >= 0 && vertex.m_BoneIDs[i] < MAX_BONES;
+    packed.BoneIDs[i] = static_cast<int8_t>(used ? vertex.m_BoneIDs[i] : -1);
+    packed.Weights[i] = used ? static_cast<uint8_t>(std::lround(std::clamp(vertex.m_Weights[i], 0.0f, 1.0f) * 255.0f)) : 0;
   }
+  return packed;
+}
 
-  fromRotation = glm::normalize(fromRotation);
-  toRotation = glm::normalize(toRotation);
-  if (glm::dot(fromRotation, toRotation) < 0.0f)
-    toRotation = -toRotation;
-
-  const float t = glm::clamp(factor, 0.0f, 1.0f);
-  const glm::vec3 scale = glm::mix(fromScale, toScale, t);
-  const glm::quat rotation = glm::normalize(glm::slerp(fromRotation, toRotation, t));
-  const glm::vec3 translation = glm::mix(fromTranslation, toTranslation, t);
+static float WrapAnimationTime(float time, float duration)
+{
+  if (!std::isfinite(time) || !std::isfinite(duration) || duration <= std::numeric_limits<float>::epsilon())
+    return 0.0f;
 
-  return glm::translate(glm::mat4(1.0f), translation) *
-         glm::toMat4(rotation) *
-         glm::scale(glm::mat4(1.0f), scale);
+  const float wrapped = std::fmod(time, duration);
+  return wrapped < 0.0f ? wrapped + duration : wrapped;
 }
 
 struct MeshTextureRange
@@ -97,11 +86,21 @@ struct ModelsData
   std::shared_ptr<StorageBuffer> m_SpecularMapFlagsSSBO;
   std::shared_ptr<StorageBuffer> m_MeshToTextureRangeSSBO;
   std::shared_ptr<StorageBuffer> m_FinalBoneMatricesSSBO;
+  // CPU copy of m_FinalBoneMatricesSSBO, MAX_BONES matrices per palette
+  // slot. Every instance of an animated model owns one slot.
+  std::vector<glm::mat4> m_BonePalettes;
+  std::vector<std::pair<Model*, uint32_t>> m_AnimatedThisFrame; // model, instance
+  std::vector<AnimationUpdate> m_AnimationUpdates; // parallel to m_AnimatedThisFrame
+  AnimationStats m_AnimationStats;
   std::shared_ptr<StorageBuffer> m_ModelIsAnimatedSSBO; 
   std::shared_ptr<StorageBuffer> m_InstanceTransformsSSBO;
   std::shared_ptr<StorageBuffer> m_VisibleInstanceTransformsSSBO;
+  // Palette slot per instance, parallel to the two transform buffers.
+  std::shared_ptr<StorageBuffer> m_InstancePalettesSSBO;
+  std::shared_ptr<StorageBuffer> m_VisibleInstancePalettesSSBO;
 
   GLuint sharedVBO, sharedEBO, sharedVAO;
+  GLenum sharedIndexType = GL_UNSIGNED_INT;
 
   std::vector<Vertex> allVertices;
   std::vector<uint32_t> allIndices;
@@ -111,17 +110,54 @@ struct ModelsData
 static void RefreshInstanceTransforms()
 {
   std::vector<glm::mat4> transforms;
+  std::vector<uint32_t> palettes;
+  uint32_t paletteCount = 0;
+  std::vector<std::pair<const Model*, uint32_t>> movedPalettes;
 
   for (const auto& modelName : s_Data.m_ModelsNames)
   {
     const auto& model = s_Data.m_Models.at(modelName);
     model->m_InstanceBase = static_cast<uint32_t>(transforms.size());
     transforms.insert(transforms.end(), model->m_InstanceTransforms.begin(), model->m_InstanceTransforms.end());
+
+    // Slots are handed out in model order, so the palettes UpdateAnimations
+    // writes form one ascending span.
+    if (model->IsAnimated())
+    {
+      model->ResizeAnimators(model->m_InstanceTransforms.size());
+      for (uint32_t instance = 0; instance < model->m_Animators.size(); ++instance)
+      {
+        Animator& animator = model->m_Animators[instance];
+        if (animator.m_PaletteSlot != paletteCount)
+          movedPalettes.emplace_back(model.get(), instance);
+        animator.m_PaletteSlot = paletteCount++;
+        palettes.push_back(animator.m_PaletteSlot);
+      }
+    }
+    else
+    {
+      palettes.insert(palettes.end(), model->m_InstanceTransforms.size(), 0u);
+    }
     Renderer::UpdateDrawCommandInstances(model);
   }
 
   if (s_Data.m_InstanceTransformsSSBO)
     s_Data.m_InstanceTransformsSSBO->SetData(transforms.size() * sizeof(glm::mat4), transforms.data());
+  if (s_Data.m_InstancePalettesSSBO)
+    s_Data.m_InstancePalettesSSBO->SetData(palettes.size() * sizeof(uint32_t), palettes.data());
+
+  const size_t paletteSize = std::max<size_t>(paletteCount, 1) * MAX_BONES;
+  const bool resized = s_Data.m_BonePalettes.size() != paletteSize;
+  s_Data.m_BonePalettes.resize(paletteSize, glm::mat4(1.0f));
+
+  // Instances that animation LOD skips would otherwise show whatever pose
+  // was left in their new slot.
+  for (const auto& [model, instance] : movedPalettes)
+    std::copy_n(model->GetBonePalette(instance), model->GetPaletteBoneCount(),
+      s_Data.m_BonePalettes.begin() + model->GetPaletteSlot(instance) * MAX_BONES);
+
+  if (s_Data.m_FinalBoneMatricesSSBO && (resized || !movedPalettes.empty()))
+    s_Data.m_FinalBoneMatricesSSBO->SetData(paletteSize * sizeof(glm::mat4), s_Data.m_BonePalettes.data());
 }
 
 void ModelManager::Init()
@@ -133,270 +169,239 @@ void ModelManager::Init()
   if (s_Data.sharedVAO == 0)
     glCreateVertexArrays(1, &s_Data.sharedVAO);
 
-  glVertexArrayVertexBuffer(s_Data.sharedVAO, 0, s_Data.sharedVBO, 0, sizeof(Vertex));
   glVertexArrayElementBuffer(s_Data.sharedVAO, s_Data.sharedEBO);
 
   struct Attribute
   {
+    GLuint location;
     GLint size;
     GLenum type;
     GLboolean normalized;
     size_t offset;
   };
 
+#if PACKED_VERTICES
+  glVertexArrayVertexBuffer(s_Data.sharedVAO, 0, s_Data.sharedVBO, 0, sizeof(PackedVertex));
+
+  // No bitangent stream (location 4); shaders take its sign from tangent.w.
+  std::array<Attribute, 6> attributes =
+  {{
+    {0, 3, GL_FLOAT,              GL_FALSE, offsetof(PackedVertex, Position)},
+    {1, 4, GL_INT_2_10_10_10_REV, GL_TRUE,  offsetof(PackedVertex, Normal)},
+    {2, 2, GL_HALF_FLOAT,         GL_FALSE, offsetof(PackedVertex, TexCoords)},
+    {3, 4, GL_INT_2_10_10_10_REV, GL_TRUE,  offsetof(PackedVertex, Tangent)},
+    {5, 4, GL_BYTE,               GL_FALSE, offsetof(PackedVertex, BoneIDs)},
+    {6, 4, GL_UNSIGNED_BYTE,      GL_TRUE,  offsetof(PackedVertex, Weights)}
+  }};
+#else
+  glVertexArrayVertexBuffer(s_Data.sharedVAO, 0, s_Data.sharedVBO, 0, sizeof(Vertex));
+
   std::array<Attribute, 7> attributes =
   {{
-    {3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Position)},
-    {3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Normal)},
-    {2, GL_FLOAT, GL_FALSE, offsetof(Vertex, TexCoords)},
-    {3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Tangent)},
-    {3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Bitangent)},
-    {4, GL_INT,   GL_FALSE, offsetof(Vertex, m_BoneIDs)},
-    {4, GL_FLOAT, GL_FALSE, offsetof(Vertex, m_Weights)}
+    {0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Position)},
+    {1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Normal)},
+    {2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, TexCoords)},
+    {3, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Tangent)},
+    {4, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, Bitangent)},
+    {5, 4, GL_INT,   GL_FALSE, offsetof(Vertex, m_BoneIDs)},
+    {6, 4, GL_FLOAT, GL_FALSE, offsetof(Vertex, m_Weights)}
   }};
+#endif
 
-  for (GLuint i = 0; i < attributes.size(); ++i)
+  for (const Attribute& attribute : attributes)
   {
+    const GLuint i = attribute.location;
     glEnableVertexArrayAttrib(s_Data.sharedVAO, i);
-    if (attributes[i].type == GL_INT)
-      glVertexArrayAttribIFormat(s_Data.sharedVAO, i, attributes[i].size, attributes[i].type, attributes[i].offset);
+    if (attribute.type == GL_INT || attribute.type == GL_BYTE)
+      glVertexArrayAttribIFormat(s_Data.sharedVAO, i, attribute.size, attribute.type, attribute.offset);
     else
-      glVertexArrayAttribFormat(s_Data.sharedVAO, i, attributes[i].size, attributes[i].type, attributes[i].normalized, attributes[i].offset);
+      glVertexArrayAttribFormat(s_Data.sharedVAO, i, attribute.size, attribute.type, attribute.normalized, attribute.offset);
     glVertexArrayAttribBinding(s_Data.sharedVAO, i, 0);
   }
 }
 
-void ModelManager::BakeModel(const std::string& path, const std::shared_ptr<Model>& model)
+// Block-compressed textures carry their full mip chain, so they skip the PBO
+// staging copy and glGenerateTextureMipmap.
+static void UploadCompressedTexture(Texture& texture)
 {
-  Timer timer;
+  const CompressedImage& image = texture.GetCompressedImage();
+  const GLenum format = texture.GetInternalFormat();
 
-  constexpr int NUM_BUFFERS = 2;
-  std::array<std::unique_ptr<PixelBuffer>, NUM_BUFFERS> pboBuffers;
-  int currentPBO = 0;
+  GLuint id;
+  glCreateTextures(GL_TEXTURE_2D, 1, &id);
+  texture.SetRendererID(id);
 
-  // Check if model has exactly one texture total shared by all meshes
-  bool singleTextureModel = false;
-
-  if (!model->GetMeshes().empty())
+  glTextureStorage2D(id, static_cast<GLsizei>(image.Mips.size()), format, image.GetWidth(), image.GetHeight());
+  for (size_t level = 0; level < image.Mips.size(); ++level)
   {
-    if (auto& firstMesh = model->GetMeshes()[0]; firstMesh.m_Textures.size() == 1)
-    {
-      auto sharedTexture = firstMesh.m_Textures[0];
-      singleTextureModel = true;
-
-      for (size_t i = 1; i < model->GetMeshes().size(); ++i)
-      {
-        auto& mesh = model->GetMeshes()[i];
-        if (mesh.m_Textures.size() != 1 || mesh.m_Textures[0] != sharedTexture)
-        {
-          singleTextureModel = false;
-          break;
-        }
-      }
-    }
+    const CompressedMip& mip = image.Mips[level];
+    StagingRing::UploadCompressedTexture2D(id, static_cast<GLint>(level), mip.Width, mip.Height, format,
+      mip.Data.data(), mip.Data.size());
   }
 
-  if (singleTextureModel)
-  {
-    GLuint64 sharedTextureHandle = 0;
-    // Bake the texture only for the first mesh
-    auto& firstMesh = model->GetMeshes()[0];
-    firstMesh.m_TexturesBindlessHandles.clear();
-
-    if (auto& texture = firstMesh.m_Textures[0])
-    {
-      int width = 0, height = 0;
-      GLenum format;
-      const void* srcData;
-      GLsizei dataSize = 0;
-
-      if (texture->IsUnCompressed())
-      {
-        if (auto* embeddedTex = texture->GetEmbeddedTexture(); embeddedTex && embeddedTex->pcData)
-        {
-          width = embeddedTex->mWidth;
-          height = embeddedTex->mHeight;
-          format = GL_RGBA;
-          dataSize = width * height * 4;
-          srcData = embeddedTex->pcData;
-        }
-        else
-          srcData = nullptr;
-      }
-      else
-      {
-        width = texture->GetWidth();
-        height = texture->GetHeight();
-        format = texture->GetDataFormat();
-        if (format != GL_RGB && format != GL_RGBA)
-          format = GL_RGBA;
-
-        int bytesPerPixel = (format == GL_RGBA) ? 4 : 3;
-        dataSize = width * height * bytesPerPixel;
-        srcData = texture->GetRawData();
-      }
-
-      if (srcData && width > 0 && height > 0)
-      {
-        if (!pboBuffers[currentPBO] || pboBuffers[currentPBO]->GetSize() != dataSize)
-          pboBuffers[currentPBO] = std::make_unique<PixelBuffer>(dataSize);
-
-        auto& pbo = pboBuffers[currentPBO];
-        pbo->WaitForCompletion();
+  glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
 
-        if (void* ptr = pbo->Map())
-        {
-          memcpy(ptr, srcData, dataSize);
-          pbo->Unmap(); // Also inserts a sync
-        }
-        else
-        {
-          GABGL_ERROR("Failed to map PixelBuffer for texture upload.");
-          // fallback - don't assign texture
-        }
+ModelBake::ModelBake(std::string path, std::shared_ptr<Model> model)
+  : m_Path(std::move(path)), m_Model(std::move(model))
+{
+  m_Name = std::filesystem::path(m_Path).stem().string();
+}
 
-        GLuint id;
-        glCreateTextures(GL_TEXTURE_2D, 1, &id);
-        texture->SetRendererID(id);
+ModelBake::~ModelBake() = default;
 
-        glTextureStorage2D(id, 1, GL_RGBA8, width, height);
-        pbo->Bind();
-        glTextureSubImage2D(id, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, nullptr);
-        pbo->Unbind();
+bool ModelBake::Step()
+{
+  if (m_Stage == Stage::DONE)
+    return true;
 
-        glGenerateTextureMipmap(id);
-        glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  Timer timer;
+  auto& meshes = m_Model->GetMeshes();
 
-        sharedTextureHandle = glGetTextureHandleARB(id);
-        glMakeTextureHandleResidentARB(sharedTextureHandle);
+  if (m_Stage == Stage::TEXTURES)
+  {
+    // One texture per step. Textures shared between meshes or, through the
+    // TextureRegistry, between models are uploaded and made resident once.
+    while (m_MeshIndex < meshes.size() && m_TextureIndex >= meshes[m_MeshIndex].m_Textures.size())
+    {
+      ++m_MeshIndex;
+      m_TextureIndex = 0;
+    }
 
-        firstMesh.m_TexturesBindlessHandles.push_back(sharedTextureHandle);
+    if (m_MeshIndex < meshes.size())
+    {
+      Mesh& mesh = meshes[m_MeshIndex];
+      if (m_TextureIndex == 0)
+        mesh.m_TexturesBindlessHandles.clear();
 
-        currentPBO = (currentPBO + 1) % NUM_BUFFERS;
+      if (const auto& texture = mesh.m_Textures[m_TextureIndex++])
+      {
+        if (texture->GetRendererID() == 0)
+        {
+          if (texture->IsCompressed()) UploadCompressedTexture(*texture);
+          else UploadRawTexture(*texture);
+        }
+        if (const GLuint64 handle = texture->MakeResident(); handle != 0)
+          mesh.m_TexturesBindlessHandles.push_back(handle);
       }
     }
-
-    // Now assign the same handle to all other meshes
-    for (size_t i = 1; i < model->GetMeshes().size(); ++i)
+    else
     {
-      auto& mesh = model->GetMeshes()[i];
-      mesh.m_TexturesBindlessHandles.clear();
-      if (sharedTextureHandle != 0)
-        mesh.m_TexturesBindlessHandles.push_back(sharedTextureHandle);
+      m_Stage = Stage::GEOMETRY;
+      m_MeshIndex = 0;
+      m_Model->m_IsRendered = m_Model->GetPhysXMeshType() != MeshType::CONVEXMESH;
     }
   }
+  else if (m_MeshIndex < meshes.size())
+  {
+    AppendMesh(m_MeshIndex++);
+  }
   else
   {
-    // Normal per-mesh texture baking
-    for (auto& mesh : model->GetMeshes())
-    {
-      mesh.m_TexturesBindlessHandles.clear();
+    if (m_Model->GetPhysXMeshType() == MeshType::TRIANGLEMESH && m_Model->GetMergeCollision())
+      m_Model->CreatePhysXMergedStaticMesh();
+    else if (m_Model->GetPhysXMeshType() == MeshType::CONVEXMESH || m_Model->GetConvexProxy())
+      m_Model->CreatePhysXConvexProxy();
 
-      for (auto& texture : mesh.m_Textures)
-      {
-        if (!texture)
-            continue;
-
-        int width, height;
-        GLenum format;
-        const void* srcData;
-        GLsizei dataSize;
-
-        if (texture->IsUnCompressed())
-        {
-            auto* embeddedTex = texture->GetEmbeddedTexture();
-            if (!embeddedTex || !embeddedTex->pcData)
-                continue;
-
-            width = embeddedTex->mWidth;
-            height = embeddedTex->mHeight;
-            format = GL_RGBA;
-            dataSize = width * height * 4;
-            srcData = embeddedTex->pcData;
-        }
-        else
-        {
-            width = texture->GetWidth();
-            height = texture->GetHeight();
-            format = texture->GetDataFormat();
-            if (format != GL_RGB && format != GL_RGBA)
-                format = GL_RGBA;
-
-            int bytesPerPixel = (format == GL_RGBA) ? 4 : 3;
-            dataSize = width * height * bytesPerPixel;
-            srcData = texture->GetRawData();
-        }
+    m_Model->m_Name = m_Name;
+    s_Data.m_Models[m_Name] = m_Model;
+    s_Data.m_ModelsNames.emplace_back(m_Name);
+    m_Stage = Stage::DONE;
+  }
 
-        if (!srcData || width <= 0 || height <= 0)
-            continue;
+  m_BakeMillis += timer.ElapsedMillis();
+  if (m_Stage == Stage::DONE)
+    GABGL_WARN("Model: {0} baking took {1} ms", m_Name, m_BakeMillis);
+  return m_Stage == Stage::DONE;
+}
 
-        if (!pboBuffers[currentPBO] || pboBuffers[currentPBO]->GetSize() != dataSize)
-            pboBuffers[currentPBO] = std::make_unique<PixelBuffer>(dataSize);
+float ModelBake::GetProgress() const
+{
+  if (m_Stage == Stage::DONE)
+    return 1.0f;
 
-        auto& pbo = pboBuffers[currentPBO];
+  const size_t meshCount = m_Model->GetMeshes().size();
+  if (meshCount == 0)
+    return 0.0f;
 
-        pbo->WaitForCompletion();
+  const float stageProgress = static_cast<float>(std::min(m_MeshIndex, meshCount)) / static_cast<float>(meshCount);
+  return m_Stage == Stage::TEXTURES ? stageProgress * 0.5f : 0.5f + stageProgress * 0.5f;
+}
 
-        if (void* ptr = pbo->Map())
-        {
-            memcpy(ptr, srcData, dataSize);
-            pbo->Unmap(); // Also inserts a sync
-        }
-        else
-        {
-            GABGL_ERROR("Failed to map PixelBuffer for texture upload.");
-            continue;
-        }
+void ModelBake::UploadRawTexture(Texture& texture)
+{
+  int width = 0, height = 0;
+  GLenum format = GL_RGBA;
+  const void* srcData = nullptr;
+  GLsizei dataSize = 0;
 
-        GLuint id;
-        glCreateTextures(GL_TEXTURE_2D, 1, &id);
-        texture->SetRendererID(id);
+  if (texture.IsUnCompressed())
+  {
+    if (auto* embeddedTex = texture.GetEmbeddedTexture(); embeddedTex && embeddedTex->pcData)
+    {
+      width = embeddedTex->mWidth;
+      height = embeddedTex->mHeight;
+      dataSize = width * height * 4;
+      srcData = embeddedTex->pcData;
+    }
+  }
+  else
+  {
+    width = texture.GetWidth();
+    height = texture.GetHeight();
+    format = texture.GetDataFormat();
+    if (format != GL_RGB && format != GL_RGBA)
+      format = GL_RGBA;
 
-        glTextureStorage2D(id, 1, GL_RGBA8, width, height);
-        pbo->Bind();
-        glTextureSubImage2D(id, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, nullptr);
-        pbo->Unbind();
+    const int bytesPerPixel = (format == GL_RGBA) ? 4 : 3;
+    dataSize = width * height * bytesPerPixel;
+    srcData = texture.GetRawData();
+  }
 
-        glGenerateTextureMipmap(id);
-        glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT );
-        glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_REPEAT );
-        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  if (!srcData || width <= 0 || height <= 0)
+    return;
 
-        GLuint64 handle = glGetTextureHandleARB(id);
-        glMakeTextureHandleResidentARB(handle);
+  GLuint id;
+  glCreateTextures(GL_TEXTURE_2D, 1, &id);
+  texture.SetRendererID(id);
 
-        mesh.m_TexturesBindlessHandles.push_back(handle);
+  glTextureStorage2D(id, 1, GL_RGBA8, width, height);
+  StagingRing::UploadTexture2D(id, 0, width, height, format, GL_UNSIGNED_BYTE, srcData, static_cast<size_t>(dataSize));
 
-        currentPBO = (currentPBO + 1) % NUM_BUFFERS;
-      }
-    }
-  }
+  glGenerateTextureMipmap(id);
+  glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
 
-  std::string name = std::filesystem::path(path).stem().string();
-  model->m_IsRendered = model->GetPhysXMeshType() != MeshType::CONVEXMESH;
+void ModelBake::AppendMesh(size_t meshIndex)
+{
+  Mesh& mesh = m_Model->GetMeshes()[meshIndex];
+  s_Data.allVertices.insert(s_Data.allVertices.end(), mesh.m_Vertices.begin(), mesh.m_Vertices.end());
+  s_Data.allIndices.insert(s_Data.allIndices.end(), mesh.m_Indices.begin(), mesh.m_Indices.end());
 
-  for (auto& mesh : model->GetMeshes())
+  std::array<uint32_t, MESH_LOD_COUNT> lodIndexCounts{ static_cast<uint32_t>(mesh.m_Indices.size()) };
+  for (size_t lod = 0; lod < mesh.m_LodIndices.size(); ++lod)
   {
-    s_Data.allVertices.insert(s_Data.allVertices.end(), mesh.m_Vertices.begin(), mesh.m_Vertices.end());
-    s_Data.allIndices.insert(s_Data.allIndices.end(), mesh.m_Indices.begin(), mesh.m_Indices.end());
-
-    Renderer::AddDrawCommand(name, static_cast<uint32_t>(mesh.m_Vertices.size()), static_cast<uint32_t>(mesh.m_Indices.size()));
+    s_Data.allIndices.insert(s_Data.allIndices.end(), mesh.m_LodIndices[lod].begin(), mesh.m_LodIndices[lod].end());
+    lodIndexCounts[lod + 1] = static_cast<uint32_t>(mesh.m_LodIndices[lod].size());
+  }
 
-    for(auto& tex : mesh.m_Textures) tex->ClearRawData();
+  Renderer::AddDrawCommand(m_Name, static_cast<uint32_t>(mesh.m_Vertices.size()), lodIndexCounts);
 
-    if(model->GetPhysXMeshType() == MeshType::TRIANGLEMESH) model->CreatePhysXStaticMesh(mesh.m_Vertices, mesh.m_Indices);
-    else if(model->GetPhysXMeshType() == MeshType::CONVEXMESH) model->CreatePhysXDynamicMesh(mesh.m_Vertices);
-  }
+  for(auto& tex : mesh.m_Textures) tex->ClearRawData();
 
-  model->m_Name = name;
-  s_Data.m_Models[name] = model;
-  s_Data.m_ModelsNames.emplace_back(name);
+  m_Model->CreatePhysXMeshCollision(meshIndex);
+}
 
-  GABGL_WARN("Model: {0} baking took {1} ms", name, timer.ElapsedMillis());
+void ModelManager::BakeModel(const std::string& path, const std::shared_ptr<Model>& model)
+{
+  ModelBake bake(path, model);
+  while (!bake.Step()) {}
 }
 
 void ModelManager::SetInitialControllerTransform(const std::string& name, const Transform& transform, float radius, float height, bool slopeLimit)
@@ -530,9 +535,18 @@ void ModelManager::SetInitialModelTransform(const std::string& name, const glm::
       return;
     }
 
+    // A model with its own proxy hulls follows its actor, like a helper.
+    if (model->GetConvexProxy() && model->m_DynamicMeshActor)
+    {
+      const auto pxTransform = PxTransform(PhysX::GlmMat4ToPxTransform(transform));
+      if (model->m_isKinematic) model->m_DynamicMeshActor->setKinematicTarget(pxTransform);
+      else model->m_DynamicMeshActor->setGlobalPose(pxTransform);
+      resolvedTransform = PhysX::PxMat44ToGlmMat4(model->m_DynamicMeshActor->getGlobalPose());
+    }
+
     int ssboIndex = static_cast<int>(std::distance(s_Data.m_ModelsNames.begin(), vecIt));
     if (s_Data.m_ModelsTransforms)
-      s_Data.m_ModelsTransforms->SetSubData(ssboIndex * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(transform));
+      s_Data.m_ModelsTransforms->SetSubData(ssboIndex * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(resolvedTransform));
   }
 
   SetModelInstanceTransform(name, 0, resolvedTransform);
@@ -562,6 +576,8 @@ bool ModelManager::RemoveModelInstance(const std::string& name, uint32_t instanc
 
   auto& model = it->second;
   model->m_InstanceTransforms.erase(model->m_InstanceTransforms.begin() + instanceIndex);
+  if (instanceIndex < model->m_Animators.size())
+    model->m_Animators.erase(model->m_Animators.begin() + instanceIndex);
   if (model->m_InstanceTransforms.empty())
   {
     model->m_IsRendered = false;
@@ -645,7 +661,7 @@ void ModelManager::SetModelInstanceTransform(const std::string& name, uint32_t i
 
 static void ReleaseModelResources()
 {
-  std::unordered_set<GLuint64> residentHandles;
+  std::unordered_set<Texture*> textures;
 
   for (const auto &model: s_Data.m_Models | std::views::values)
   {
@@ -665,18 +681,22 @@ static void ReleaseModelResources()
       model->m_DynamicMeshActor = nullptr;
     }
 
-    for (const auto& mesh : model->m_Meshes)
-      residentHandles.insert(mesh.m_TexturesBindlessHandles.begin(), mesh.m_TexturesBindlessHandles.end());
+    for (auto& mesh : model->m_Meshes)
+    {
+      for (const auto& texture : mesh.m_Textures)
+        if (texture) textures.insert(texture.get());
+      mesh.m_TexturesBindlessHandles.clear();
+    }
   }
 
-  for (const GLuint64 handle : residentHandles)
-  {
-    if (handle != 0)
-      glMakeTextureHandleNonResidentARB(handle);
-  }
+  // Textures may outlive this scene through the TextureRegistry (a model
+  // still importing holds them), so residency is dropped explicitly.
+  for (Texture* texture : textures)
+    texture->MakeNonResident();
 
   s_Data.m_Models.clear();
   s_Data.m_ModelsNames.clear();
+  TextureRegistry::Prune();
   s_Data.allVertices.clear();
   s_Data.allIndices.clear();
 
@@ -687,9 +707,15 @@ static void ReleaseModelResources()
   s_Data.m_SpecularMapFlagsSSBO.reset();
   s_Data.m_MeshToTextureRangeSSBO.reset();
   s_Data.m_FinalBoneMatricesSSBO.reset();
+  s_Data.m_BonePalettes.clear();
+  s_Data.m_AnimatedThisFrame.clear();
+  s_Data.m_AnimationUpdates.clear();
+  s_Data.m_AnimationStats = {};
   s_Data.m_ModelIsAnimatedSSBO.reset();
   s_Data.m_InstanceTransformsSSBO.reset();
   s_Data.m_VisibleInstanceTransformsSSBO.reset();
+  s_Data.m_InstancePalettesSSBO.reset();
+  s_Data.m_VisibleInstancePalettesSSBO.reset();
 
   if (s_Data.sharedVBO) glDeleteBuffers(1, &s_Data.sharedVBO);
   if (s_Data.sharedEBO) glDeleteBuffers(1, &s_Data.sharedEBO);
@@ -697,6 +723,7 @@ static void ReleaseModelResources()
   s_Data.sharedVBO = 0;
   s_Data.sharedEBO = 0;
   s_Data.sharedVAO = 0;
+  s_Data.sharedIndexType = GL_UNSIGNED_INT;
 }
 
 void ModelManager::Reset()
@@ -712,28 +739,24 @@ void ModelManager::Shutdown()
 
 void ModelManager::UpdateTransforms(const DeltaTime& dt)
 {
+  UpdateAnimations(dt);
+
   for (const auto& [key, model] : s_Data.m_Models)
   {
-    if(model->IsAnimated() && model->m_IsRendered)
-    { 
-      model->UpdateAnimation(dt);
-      auto& transforms = model->GetFinalBoneMatrices();
+    if (model->GetConvexProxy())
+    {
+      if (!model->m_IsRendered || !model->GetDynamicActor())
+        continue;
 
-      auto nameIt = std::ranges::find(s_Data.m_ModelsNames, key);
-      if (nameIt != s_Data.m_ModelsNames.end())
+      const glm::mat4 actorTransform = PhysX::PxMat44ToGlmMat4(model->GetDynamicActor()->getGlobalPose());
+      if (auto nameIt = std::ranges::find(s_Data.m_ModelsNames, key); nameIt != s_Data.m_ModelsNames.end())
       {
         int ssboIndex = static_cast<int>(std::distance(s_Data.m_ModelsNames.begin(), nameIt));
-        const size_t offset = static_cast<size_t>(ssboIndex) * MAX_BONES * sizeof(glm::mat4);
-        const size_t matrixCount = std::min(transforms.size(), static_cast<size_t>(MAX_BONES));
-        const size_t size = matrixCount * sizeof(glm::mat4);
-
-        if (size > 0)
-          s_Data.m_FinalBoneMatricesSSBO->SetSubData(offset, size, transforms.data());
-      }
-      else
-      {
-        GABGL_WARN("Animated model '{}' not found in name list for bone SSBO!", key);
+        if (s_Data.m_ModelsTransforms)
+          s_Data.m_ModelsTransforms->SetSubData(ssboIndex * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(actorTransform));
       }
+      SetModelInstanceTransform(key, 0, actorTransform);
+      continue;
     }
 
     const std::string& convexName = key;
@@ -769,6 +792,70 @@ void ModelManager::UpdateTransforms(const DeltaTime& dt)
   }
 }
 
+void ModelManager::UpdateAnimations(const DeltaTime& dt)
+{
+  // Slot order, so the touched palettes form one ascending span.
+  auto& animated = s_Data.m_AnimatedThisFrame;
+  animated.clear();
+  for (const auto& modelName : s_Data.m_ModelsNames)
+  {
+    const auto it = s_Data.m_Models.find(modelName);
+    if (it == s_Data.m_Models.end() || !it->second->IsAnimated() || !it->second->m_IsRendered)
+      continue;
+    for (uint32_t instance = 0; instance < it->second->m_Animators.size(); ++instance)
+      animated.emplace_back(it->second.get(), instance);
+  }
+
+  auto& stats = s_Data.m_AnimationStats;
+  stats = {};
+  if (animated.empty() || !s_Data.m_FinalBoneMatricesSSBO)
+    return;
+
+  // Animators only touch their own state and the model's clips are read
+  // only, so instances of one model can run on different workers. Every
+  // instance writes its own slice of the palette copy.
+  auto& updates = s_Data.m_AnimationUpdates;
+  updates.resize(animated.size());
+  JobSystem::ParallelFor(animated.size(), 1, [&animated, &updates, &dt](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      const auto [model, instance] = animated[i];
+      updates[i] = model->UpdateAnimation(instance, dt);
+      if (updates[i] == AnimationUpdate::FULL || updates[i] == AnimationUpdate::REDUCED)
+        std::copy_n(model->GetBonePalette(instance), model->GetPaletteBoneCount(),
+          s_Data.m_BonePalettes.begin() + model->GetPaletteSlot(instance) * MAX_BONES);
+    }
+  });
+
+  // Skipped instances keep last frame's palette on the GPU; only the span
+  // between the first and last evaluated one is uploaded.
+  size_t first = std::numeric_limits<size_t>::max();
+  size_t last = 0;
+  for (size_t i = 0; i < animated.size(); ++i)
+  {
+    switch (updates[i])
+    {
+      case AnimationUpdate::FULL:      ++stats.full; break;
+      case AnimationUpdate::REDUCED:   ++stats.reduced; break;
+      case AnimationUpdate::THROTTLED: ++stats.throttled; continue;
+      case AnimationUpdate::FROZEN:    ++stats.frozen; continue;
+    }
+    const size_t slot = animated[i].first->GetPaletteSlot(animated[i].second);
+    first = std::min(first, slot * MAX_BONES);
+    last = std::max(last, (slot + 1) * MAX_BONES);
+  }
+
+  if (first < last)
+    s_Data.m_FinalBoneMatricesSSBO->SetSubData(first * sizeof(glm::mat4), (last - first) * sizeof(glm::mat4),
+      s_Data.m_BonePalettes.data() + first);
+}
+
+const AnimationStats& ModelManager::GetAnimationStats()
+{
+  return s_Data.m_AnimationStats;
+}
+
 void ModelManager::SetRender(const std::string& name, bool render)
 {
   auto it = s_Data.m_Models.find(name);
@@ -793,34 +880,94 @@ GLuint ModelManager::GetModelsVAO()
   return s_Data.sharedVAO;
 }
 
-void ModelManager::UploadVisibleInstanceTransforms(const std::vector<glm::mat4>& transforms)
+GLenum ModelManager::GetModelsIndexType()
+{
+  return s_Data.sharedIndexType;
+}
+
+GLsizeiptr ModelManager::GetModelsIndexSize()
+{
+  return s_Data.sharedIndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+void ModelManager::UploadVisibleInstanceTransforms(const std::vector<glm::mat4>& transforms, const std::vector<uint32_t>& palettes)
 {
-  if (!s_Data.m_VisibleInstanceTransformsSSBO)
+  if (!s_Data.m_VisibleInstanceTransformsSSBO || !s_Data.m_VisibleInstancePalettesSSBO)
     return;
 
   if (!transforms.empty())
     s_Data.m_VisibleInstanceTransformsSSBO->SetData(transforms.size() * sizeof(glm::mat4),
       transforms.data());
-  s_Data.m_VisibleInstanceTransformsSSBO->Bind();
+  if (!palettes.empty())
+    s_Data.m_VisibleInstancePalettesSSBO->SetData(palettes.size() * sizeof(uint32_t), palettes.data());
+  BindVisibleInstanceTransforms();
 }
 
 void ModelManager::BindAllInstanceTransforms()
 {
   if (s_Data.m_InstanceTransformsSSBO)
     s_Data.m_InstanceTransformsSSBO->Bind();
+  if (s_Data.m_InstancePalettesSSBO)
+    s_Data.m_InstancePalettesSSBO->Bind();
 }
 
 void ModelManager::BindVisibleInstanceTransforms()
 {
   if (s_Data.m_VisibleInstanceTransformsSSBO)
     s_Data.m_VisibleInstanceTransformsSSBO->Bind();
+  if (s_Data.m_VisibleInstancePalettesSSBO)
+    s_Data.m_VisibleInstancePalettesSSBO->Bind();
 }
 
 void ModelManager::UploadToGPU()
 {
-  glNamedBufferStorage(s_Data.sharedVBO, s_Data.allVertices.size() * sizeof(Vertex), s_Data.allVertices.data(), 0);
-  glNamedBufferStorage(s_Data.sharedEBO, s_Data.allIndices.size() * sizeof(uint32_t), s_Data.allIndices.data(), 0);
+  UploadGeometry();
+  CreateStorageBuffers();
+}
+
+// GPU-only storage filled through the staging ring.
+static void UploadImmutable(GLuint buffer, const void* data, size_t size)
+{
+  glNamedBufferStorage(buffer, (GLsizeiptr)std::max<size_t>(size, 1), nullptr, 0);
+  if (size > 0)
+    StagingRing::UploadBuffer(buffer, 0, data, size);
+}
+
+void ModelManager::UploadGeometry()
+{
+#if PACKED_VERTICES
+  std::vector<PackedVertex> packedVertices(s_Data.allVertices.size());
+  JobSystem::ParallelFor(packedVertices.size(), 4096, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      packedVertices[i] = PackVertex(s_Data.allVertices[i]);
+  });
+  UploadImmutable(s_Data.sharedVBO, packedVertices.data(), packedVertices.size() * sizeof(PackedVertex));
+#else
+  UploadImmutable(s_Data.sharedVBO, s_Data.allVertices.data(), s_Data.allVertices.size() * sizeof(Vertex));
+#endif
 
+  // Indices are mesh-local (draws use baseVertex), so one 16-bit buffer works
+  // as long as no single mesh has more than 65535 vertices.
+  const bool fitsShortIndices = std::ranges::all_of(s_Data.allIndices, [](uint32_t index) { return index <= 0xFFFF; });
+  if (fitsShortIndices)
+  {
+    std::vector<uint16_t> shortIndices(s_Data.allIndices.begin(), s_Data.allIndices.end());
+    UploadImmutable(s_Data.sharedEBO, shortIndices.data(), shortIndices.size() * sizeof(uint16_t));
+    s_Data.sharedIndexType = GL_UNSIGNED_SHORT;
+  }
+  else
+  {
+    UploadImmutable(s_Data.sharedEBO, s_Data.allIndices.data(), s_Data.allIndices.size() * sizeof(uint32_t));
+    s_Data.sharedIndexType = GL_UNSIGNED_INT;
+  }
+
+  s_Data.allVertices.clear();
+  s_Data.allIndices.clear();
+}
+
+void ModelManager::CreateStorageBuffers()
+{
   s_Data.m_ModelsTransforms = StorageBuffer::Create(sizeof(glm::mat4) * s_Data.m_Models.size(), 5);
 
   auto transform = GetTransforms();
@@ -828,8 +975,14 @@ void ModelManager::UploadToGPU()
 
   s_Data.m_InstanceTransformsSSBO = StorageBuffer::Create(sizeof(glm::mat4), 13);
   s_Data.m_VisibleInstanceTransformsSSBO = StorageBuffer::Create(sizeof(glm::mat4), 13);
+  s_Data.m_InstancePalettesSSBO = StorageBuffer::Create(sizeof(uint32_t), 15);
+  s_Data.m_VisibleInstancePalettesSSBO = StorageBuffer::Create(sizeof(uint32_t), 15);
+  // Sized to the palette slots by RefreshInstanceTransforms.
+  s_Data.m_BonePalettes.assign(MAX_BONES, glm::mat4(1.0f));
+  s_Data.m_FinalBoneMatricesSSBO = StorageBuffer::Create(s_Data.m_BonePalettes.size() * sizeof(glm::mat4), 9);
+  s_Data.m_FinalBoneMatricesSSBO->SetData(s_Data.m_BonePalettes.size() * sizeof(glm::mat4), s_Data.m_BonePalettes.data());
   RefreshInstanceTransforms();
-  s_Data.m_InstanceTransformsSSBO->Bind();
+  BindAllInstanceTransforms();
 
   std::vector<int> meshToTransformIndex;
 
@@ -841,7 +994,8 @@ void ModelManager::UploadToGPU()
 
       int meshCount = model->GetMeshes().size(); 
 
-      for (int i = 0; i < meshCount; ++i)
+      // One draw command per mesh LOD, so per-draw data repeats per LOD.
+      for (int i = 0; i < meshCount * MESH_LOD_COUNT; ++i)
       {
           meshToTransformIndex.push_back(modelIndex); 
           currentMeshIndex++;
@@ -862,8 +1016,8 @@ void ModelManager::UploadToGPU()
 
     for (const auto& meshes = model->GetMeshes(); const auto & mesh : meshes)
     {
-      mesh.hasNormalMap ? normalMapFlags.push_back(1) : normalMapFlags.push_back(0);
-      mesh.hasSpecularMap ? specularMapFlags.push_back(1) : specularMapFlags.push_back(0);  
+      normalMapFlags.insert(normalMapFlags.end(), MESH_LOD_COUNT, mesh.hasNormalMap ? 1 : 0);
+      specularMapFlags.insert(specularMapFlags.end(), MESH_LOD_COUNT, mesh.hasSpecularMap ? 1 : 0);
 
       MeshTextureRange range{};
       range.StartIndex = static_cast<uint32_t>(textureHandles.size());
@@ -874,7 +1028,7 @@ void ModelManager::UploadToGPU()
        textureHandles.push_back(handle);
       }
 
-      meshTextureRanges.push_back(range);
+      meshTextureRanges.insert(meshTextureRanges.end(), MESH_LOD_COUNT, range);
     }
   }
 
@@ -884,11 +1038,6 @@ void ModelManager::UploadToGPU()
   s_Data.m_MeshToTextureRangeSSBO = StorageBuffer::Create(meshTextureRanges.size() * sizeof(MeshTextureRange), 8);
   s_Data.m_MeshToTextureRangeSSBO->SetData(meshTextureRanges.size() * sizeof(MeshTextureRange), meshTextureRanges.data());
   
-  std::vector identityBones(s_Data.m_Models.size() * MAX_BONES, glm::mat4(1.0f));
-
-  s_Data.m_FinalBoneMatricesSSBO = StorageBuffer::Create(identityBones.size() * sizeof(glm::mat4), 9);
-  s_Data.m_FinalBoneMatricesSSBO->SetData(identityBones.size() * sizeof(glm::mat4), identityBones.data());
-
   std::vector<int> isAnimatedFlags;
 
   for (const auto& modelName : s_Data.m_ModelsNames)
@@ -916,9 +1065,6 @@ void ModelManager::UploadToGPU()
       }
     }
   }
-
-  s_Data.allVertices.clear();
-  s_Data.allIndices.clear();
 }
 
 void ModelManager::MoveController(const std::string& name, const Movement& movement, float speed, const DeltaTime& dt)
@@ -1086,6 +1232,23 @@ Model::Model(const char* path, float optimizerStrength, bool isAnimated, bool is
 {
   Timer timer;
 
+  std::string dirStr = std::filesystem::path(path).parent_path().string();
+  m_Directory = dirStr;
+
+  if (ModelCache::Load(path, *this))
+  {
+    if (m_isAnimated)
+    {
+      GABGL_ASSERT(!m_ProcessedAnimations.empty(),"[MODEL]: Model doesnt contain animations");
+      BuildSkeleton();
+      SetAnimationbyIndex(0);
+    }
+
+    m_Scene = nullptr;
+    GABGL_WARN("Model loading took {0} ms", timer.ElapsedMillis());
+    return;
+  }
+
   Assimp::Importer importer;
   if(m_isAnimated) m_Scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | aiProcess_CalcTangentSpace);
   else m_Scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | aiProcess_CalcTangentSpace);
@@ -1095,15 +1258,15 @@ Model::Model(const char* path, float optimizerStrength, bool isAnimated, bool is
     GABGL_ERROR("[MODEL]: {0}", static_cast<std::string>(importer.GetErrorString()));
     return;
   }
-  std::string dirStr = std::filesystem::path(path).parent_path().string();
-  m_Directory = dirStr;
 
   const glm::mat4 rootTransform = AssimpMatToGLMMat(m_Scene->mRootNode->mTransformation);
   const float rootDeterminant = glm::determinant(rootTransform);
   if (std::abs(rootDeterminant) > std::numeric_limits<float>::epsilon())
     m_GlobalInverseTransform = glm::inverse(rootTransform);
 
-  processNode(m_Scene->mRootNode, m_Scene);
+  std::vector<aiMesh*> meshes;
+  processNode(m_Scene->mRootNode, m_Scene, meshes);
+  processMeshes(meshes, m_Scene);
 
   glm::vec3 boundsMin(std::numeric_limits<float>::max());
   glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
@@ -1132,6 +1295,8 @@ Model::Model(const char* path, float optimizerStrength, bool isAnimated, bool is
 
   if(isAnimated)
   {
+    ReadHierarchyData(m_RootNode, m_Scene->mRootNode);
+
     for (unsigned int i = 0; i < m_Scene->mNumAnimations; ++i)
     {
       aiAnimation* animation = m_Scene->mAnimations[i];
@@ -1160,40 +1325,65 @@ Model::Model(const char* path, float optimizerStrength, bool isAnimated, bool is
         animData.duration = std::max(static_cast<float>(lastKeyTime), 1.0f);
       }
 
-      ReadHierarchyData(animData.hierarchy, m_Scene->mRootNode);
-      ReadMissingBones(animation);
-
-      animData.bones = m_Bones;
+      ReadMissingBones(animation, animData.bones);
 
       GABGL_INFO("Model: {},  Animation at index: {}, {}", std::filesystem::path(path).stem().string(), std::to_string(i), animData.name);
 
-      m_ProcessedAnimations.emplace_back(animData);
+      m_ProcessedAnimations.emplace_back(std::move(animData));
     }
 
     GABGL_ASSERT(!m_ProcessedAnimations.empty(),"[MODEL]: Model doesnt contain animations");
 
+    BuildSkeleton();
     SetAnimationbyIndex(0);
-
-    ResizeFinalBoneMatrices();
   }
 
+  ModelCache::Save(path, *this);
+
   m_TexturesLoaded.clear();
 
   GABGL_WARN("Model loading took {0} ms", timer.ElapsedMillis());
 }
 
-void Model::processNode(aiNode* node, const aiScene* scene)
+void Model::processNode(aiNode* node, const aiScene* scene, std::vector<aiMesh*>& outMeshes)
 {
   for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-      aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-      m_Meshes.emplace_back(processMesh(mesh, scene));
+      outMeshes.emplace_back(scene->mMeshes[node->mMeshes[i]]);
   }
   for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-      processNode(node->mChildren[i], scene);
+      processNode(node->mChildren[i], scene, outMeshes);
   }
 }
 
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
+void Model::processMeshes(const std::vector<aiMesh*>& meshes, const aiScene* scene)
+{
+  // Bone IDs and the texture table are shared by every mesh, so they are
+  // assigned serially in node order; this keeps IDs identical to a serial load.
+  m_Meshes.resize(meshes.size());
+  for (size_t i = 0; i < meshes.size(); ++i)
+  {
+    if (m_isAnimated) RegisterBones(meshes[i]);
+    loadMeshTextures(meshes[i], scene, m_Meshes[i]);
+  }
+
+  // Textures were only registered above; decode them all at once so a model
+  // with many materials does not pay for each image serially.
+  std::vector<std::shared_ptr<Texture>> textures;
+  textures.reserve(m_TexturesLoaded.size());
+  for (const auto& [path, texture] : m_TexturesLoaded)
+    textures.emplace_back(texture);
+  Texture::DecodeAll(textures);
+
+  // Vertex conversion, skinning weights and the meshoptimizer pipeline only
+  // touch their own Mesh, so they fan out. Results land at their node index.
+  std::vector<JobHandle> jobs;
+  jobs.reserve(meshes.size());
+  for (size_t i = 0; i < meshes.size(); ++i)
+    jobs.emplace_back(JobSystem::Submit([this, &meshes, i]() { processMesh(meshes[i], m_Meshes[i]); }));
+  JobSystem::Wait(jobs);
+}
+
+void Model::processMesh(const aiMesh* mesh, Mesh& result) const
 {
   std::vector<Vertex> vertices;
   vertices.reserve(mesh->mNumVertices);
@@ -1221,6 +1411,17 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
     indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
   }
 
+  if (m_isAnimated) ExtractBoneWeightForVertices(vertices, mesh);
+  OptimizeMesh(vertices, indices);
+  if (!m_isAnimated) BuildMeshlets(vertices, indices, result.m_Meshlets);
+  GenerateLods(vertices, indices, result.m_LodIndices);
+
+  result.m_Vertices = std::move(vertices);
+  result.m_Indices = std::move(indices);
+}
+
+void Model::loadMeshTextures(const aiMesh* mesh, const aiScene* scene, Mesh& result)
+{
   std::vector<std::shared_ptr<Texture>> textures;
   bool hasNormalMap = false;
   bool hasSpecular = false;
@@ -1237,14 +1438,9 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
     // loadMaterialTextures(material, aiTextureType_BASE_COLOR, "texture_albedo", textures);
   }
 
-  if (m_isAnimated) ExtractBoneWeightForVertices(vertices, mesh);
-  OptimizeMesh(vertices, indices);
-
-  Mesh result(vertices, indices, textures);
+  result.m_Textures = std::move(textures);
   result.hasNormalMap = hasNormalMap;
   result.hasSpecularMap = hasSpecular;
-
-  return result;
 }
 
 bool Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, std::vector<std::shared_ptr<Texture>>& textures)
@@ -1266,14 +1462,13 @@ bool Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std:
 
       if (texturePath[0] == '*') {
         if (const aiTexture* aitexture = m_Scene->GetEmbeddedTexture(str.C_Str())) {
-              texture = Texture::CreateEMBEDDED(aitexture, texturePath);
+              texture = TextureRegistry::AcquireEmbedded(aitexture, texturePath, typeName);
           }
       } else {
-          texture = Texture::Create(texturePath, m_Directory);
+          texture = TextureRegistry::AcquireFile(texturePath, m_Directory, typeName);
       }
 
       if (texture) {
-          texture->SetType(typeName);
           textures.emplace_back(texture);
           m_TexturesLoaded[texturePath] = texture;
           loadedAny = true;
@@ -1283,7 +1478,7 @@ bool Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std:
   return loadedAny;
 }
 
-void Model::OptimizeMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices)
+void Model::OptimizeMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices) const
 {
   std::vector<GLuint> remap(m_Indices.size());
 
@@ -1308,21 +1503,314 @@ void Model::OptimizeMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m
   m_Vertices = std::move(OptVertices);
 }
 
-void Model::CreatePhysXStaticMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices)
+void Model::GenerateLods(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices, std::array<std::vector<GLuint>, MESH_LOD_COUNT - 1>& lods) const
+{
+  // Each level halves the previous triangle budget. Once meshopt can no longer
+  // reduce within the error bound, the remaining levels repeat the last one so
+  // every mesh still owns MESH_LOD_COUNT draw ranges.
+  constexpr float LOD_ERROR = 0.05f;
+
+  const std::vector<GLuint>* previous = &indices;
+  for (size_t level = 0; level < lods.size(); ++level)
+  {
+    std::vector<GLuint>& lod = lods[level];
+    const size_t targetCount = (previous->size() / 2) / 3 * 3;
+
+    std::vector<GLuint> simplified(previous->size());
+    const size_t simplifiedCount = previous->empty() ? 0 : meshopt_simplify(simplified.data(), previous->data(), previous->size(),
+      &vertices[0].Position.x, vertices.size(), sizeof(Vertex), targetCount, LOD_ERROR * (level + 1));
+
+    if (simplifiedCount == 0 || simplifiedCount >= previous->size())
+    {
+      lod = *previous;
+    }
+    else
+    {
+      simplified.resize(simplifiedCount);
+      meshopt_optimizeVertexCache(simplified.data(), simplified.data(), simplifiedCount, vertices.size());
+      lod = std::move(simplified);
+    }
+
+    previous = &lod;
+  }
+}
+
+void Model::BuildMeshlets(const std::vector<Vertex>& vertices, std::vector<GLuint>& indices, std::vector<Meshlet>& meshlets) const
+{
+  // Reorders `indices` so every meshlet is one contiguous range. Cone weight
+  // 0.25 trades a little vertex reuse for tighter normal cones.
+  constexpr float CONE_WEIGHT = 0.25f;
+
+  meshlets.clear();
+  if (indices.size() / 3 < MESHLET_MIN_TRIANGLES)
+    return;
+
+  const size_t maxMeshlets = meshopt_buildMeshletsBound(indices.size(), MESHLET_MAX_VERTICES, MESHLET_MAX_TRIANGLES);
+  std::vector<meshopt_Meshlet> built(maxMeshlets);
+  std::vector<unsigned int> meshletVertices(maxMeshlets * MESHLET_MAX_VERTICES);
+  std::vector<unsigned char> meshletTriangles(maxMeshlets * MESHLET_MAX_TRIANGLES * 3);
+
+  const size_t meshletCount = meshopt_buildMeshlets(built.data(), meshletVertices.data(), meshletTriangles.data(),
+    indices.data(), indices.size(), &vertices[0].Position.x, vertices.size(), sizeof(Vertex),
+    MESHLET_MAX_VERTICES, MESHLET_MAX_TRIANGLES, CONE_WEIGHT);
+
+  std::vector<GLuint> ordered;
+  ordered.reserve(indices.size());
+  meshlets.reserve(meshletCount);
+  for (size_t i = 0; i < meshletCount; ++i)
+  {
+    const meshopt_Meshlet& source = built[i];
+    const unsigned int* localVertices = &meshletVertices[source.vertex_offset];
+    const unsigned char* localTriangles = &meshletTriangles[source.triangle_offset];
+
+    const meshopt_Bounds bounds = meshopt_computeMeshletBounds(localVertices, localTriangles, source.triangle_count,
+      &vertices[0].Position.x, vertices.size(), sizeof(Vertex));
+
+    Meshlet& meshlet = meshlets.emplace_back();
+    meshlet.FirstIndex = static_cast<uint32_t>(ordered.size());
+    meshlet.IndexCount = source.triangle_count * 3;
+    meshlet.Center = glm::vec3(bounds.center[0], bounds.center[1], bounds.center[2]);
+    meshlet.Radius = bounds.radius;
+    meshlet.ConeApex = glm::vec3(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]);
+    meshlet.ConeAxis = glm::vec3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+    meshlet.ConeCutoff = bounds.cone_cutoff;
+
+    for (size_t t = 0; t < size_t(source.triangle_count) * 3; ++t)
+      ordered.push_back(localVertices[localTriangles[t]]);
+  }
+
+  indices = std::move(ordered);
+}
+
+std::vector<uint8_t> Model::CookStaticMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
 {
-  std::vector<PxVec3> physxVertices(m_Vertices.size());
-  for (size_t i = 0; i < m_Vertices.size(); ++i) {
+  std::vector<PxVec3> physxVertices(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
       physxVertices[i] = PxVec3(
-          m_Vertices[i].Position.x,
-          m_Vertices[i].Position.y,
-          m_Vertices[i].Position.z
+          vertices[i].Position.x,
+          vertices[i].Position.y,
+          vertices[i].Position.z
       );
   }
 
-  PxTriangleMesh* physxMesh = PhysX::CreateTriangleMesh(
+  return PhysX::CookTriangleMesh(
       static_cast<PxU32>(physxVertices.size()), physxVertices.data(),
-      static_cast<PxU32>(m_Indices.size() / 3), m_Indices.data()
+      static_cast<PxU32>(indices.size() / 3), indices.data()
   );
+}
+
+std::vector<uint8_t> Model::CookDynamicMesh(const std::vector<Vertex>& vertices)
+{
+  std::vector<PxVec3> physxVertices(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i)
+  {
+      physxVertices[i] = PxVec3(vertices[i].Position.x, vertices[i].Position.y, vertices[i].Position.z);
+  }
+
+  return PhysX::CookConvexMesh(static_cast<PxU32>(physxVertices.size()), physxVertices.data());
+}
+
+std::vector<uint8_t> Model::CookMergedStaticMesh() const
+{
+  std::vector<PxVec3> physxVertices;
+  std::vector<PxU32> physxIndices;
+  for (const Mesh& mesh : m_Meshes)
+  {
+    const PxU32 baseVertex = static_cast<PxU32>(physxVertices.size());
+    for (const Vertex& vertex : mesh.m_Vertices)
+      physxVertices.emplace_back(vertex.Position.x, vertex.Position.y, vertex.Position.z);
+    for (const GLuint index : mesh.m_Indices)
+      physxIndices.push_back(baseVertex + index);
+  }
+
+  if (physxIndices.empty())
+    return {};
+
+  return PhysX::CookTriangleMesh(
+      static_cast<PxU32>(physxVertices.size()), physxVertices.data(),
+      static_cast<PxU32>(physxIndices.size() / 3), physxIndices.data()
+  );
+}
+
+// Groups the meshes into at most CONVEX_HULL_MAX_COUNT clusters by their
+// bounds centres (farthest-point seeds, then a few Lloyd iterations) and
+// returns each cluster's points welded on a grid. Deterministic, so the
+// cooked hulls keep hitting the PhysXCache.
+std::vector<std::vector<PxVec3>> Model::BuildConvexProxy() const
+{
+  glm::vec3 modelMin(std::numeric_limits<float>::max());
+  glm::vec3 modelMax(std::numeric_limits<float>::lowest());
+  std::vector<size_t> meshes;
+  std::vector<glm::vec3> centers;
+  for (size_t i = 0; i < m_Meshes.size(); ++i)
+  {
+    if (m_Meshes[i].m_Vertices.empty())
+      continue;
+
+    glm::vec3 meshMin(std::numeric_limits<float>::max());
+    glm::vec3 meshMax(std::numeric_limits<float>::lowest());
+    for (const Vertex& vertex : m_Meshes[i].m_Vertices)
+    {
+      meshMin = glm::min(meshMin, vertex.Position);
+      meshMax = glm::max(meshMax, vertex.Position);
+    }
+    modelMin = glm::min(modelMin, meshMin);
+    modelMax = glm::max(modelMax, meshMax);
+    meshes.push_back(i);
+    centers.push_back((meshMin + meshMax) * 0.5f);
+  }
+
+  if (meshes.empty())
+    return {};
+
+  const size_t hullCount = std::min<size_t>(meshes.size(), CONVEX_HULL_MAX_COUNT);
+  std::vector<glm::vec3> seeds{ centers[0] };
+  std::vector<float> seedDistance(centers.size(), std::numeric_limits<float>::max());
+  while (seeds.size() < hullCount)
+  {
+    for (size_t i = 0; i < centers.size(); ++i)
+      seedDistance[i] = std::min(seedDistance[i], glm::distance(centers[i], seeds.back()));
+    seeds.push_back(centers[std::ranges::max_element(seedDistance) - seedDistance.begin()]);
+  }
+
+  std::vector<size_t> cluster(centers.size(), 0);
+  for (int iteration = 0; iteration < 4; ++iteration)
+  {
+    for (size_t i = 0; i < centers.size(); ++i)
+    {
+      float best = std::numeric_limits<float>::max();
+      for (size_t s = 0; s < seeds.size(); ++s)
+      {
+        if (const float d = glm::distance(centers[i], seeds[s]); d < best)
+        {
+          best = d;
+          cluster[i] = s;
+        }
+      }
+    }
+
+    std::vector<glm::vec3> sums(seeds.size(), glm::vec3(0.0f));
+    std::vector<size_t> counts(seeds.size(), 0);
+    for (size_t i = 0; i < centers.size(); ++i)
+    {
+      sums[cluster[i]] += centers[i];
+      ++counts[cluster[i]];
+    }
+    for (size_t s = 0; s < seeds.size(); ++s)
+      if (counts[s] > 0)
+        seeds[s] = sums[s] / static_cast<float>(counts[s]);
+  }
+
+  const glm::vec3 extent = glm::max(modelMax - modelMin, glm::vec3(1e-6f));
+  const glm::vec3 cellScale = glm::vec3(static_cast<float>(CONVEX_HULL_WELD_CELLS)) / extent;
+
+  std::vector<std::vector<PxVec3>> hulls(seeds.size());
+  std::vector<std::unordered_set<uint64_t>> welded(seeds.size());
+  for (size_t i = 0; i < meshes.size(); ++i)
+  {
+    for (const Vertex& vertex : m_Meshes[meshes[i]].m_Vertices)
+    {
+      const glm::uvec3 cell = glm::uvec3((vertex.Position - modelMin) * cellScale);
+      const uint64_t key = (uint64_t(cell.x) << 42) | (uint64_t(cell.y) << 21) | uint64_t(cell.z);
+      if (welded[cluster[i]].insert(key).second)
+        hulls[cluster[i]].emplace_back(vertex.Position.x, vertex.Position.y, vertex.Position.z);
+    }
+  }
+
+  std::erase_if(hulls, [](const std::vector<PxVec3>& points) { return points.size() < 4; });
+  return hulls;
+}
+
+std::vector<std::vector<uint8_t>> Model::CookConvexProxy() const
+{
+  const std::vector<std::vector<PxVec3>> hulls = BuildConvexProxy();
+
+  std::vector<std::vector<uint8_t>> cooked(hulls.size());
+  JobSystem::ParallelFor(hulls.size(), 1, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      cooked[i] = PhysX::CookConvexMesh(static_cast<PxU32>(hulls[i].size()), hulls[i].data(),
+        CONVEX_HULL_VERTEX_LIMIT, CONVEX_HULL_QUANTIZED_COUNT);
+  });
+  return cooked;
+}
+
+void Model::CookCollision()
+{
+  m_CookedCollision.clear();
+
+  if (m_meshType == MeshType::CONVEXMESH || m_ConvexProxy)
+  {
+    m_CookedCollision = CookConvexProxy();
+    return;
+  }
+
+  if (m_meshType != MeshType::TRIANGLEMESH)
+    return;
+
+  if (m_MergeCollision)
+  {
+    m_CookedCollision.emplace_back(CookMergedStaticMesh());
+    return;
+  }
+
+  m_CookedCollision.resize(m_Meshes.size());
+  JobSystem::ParallelFor(m_Meshes.size(), 1, [this](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      m_CookedCollision[i] = CookStaticMesh(m_Meshes[i].m_Vertices, m_Meshes[i].m_Indices);
+  });
+}
+
+void Model::CreatePhysXMeshCollision(size_t meshIndex)
+{
+  if (m_meshType != MeshType::TRIANGLEMESH || m_MergeCollision)
+    return;
+
+  Mesh& mesh = m_Meshes[meshIndex];
+  if (meshIndex < m_CookedCollision.size() && !m_CookedCollision[meshIndex].empty())
+  {
+    AddPhysXStaticShape(m_CookedCollision[meshIndex]);
+    std::vector<uint8_t>().swap(m_CookedCollision[meshIndex]);
+  }
+  else
+  {
+    CreatePhysXStaticMesh(mesh.m_Vertices, mesh.m_Indices);
+  }
+}
+
+void Model::CreatePhysXConvexProxy()
+{
+  if (m_CookedCollision.empty())
+    m_CookedCollision = CookConvexProxy();
+
+  for (const std::vector<uint8_t>& cooked : m_CookedCollision)
+    if (!cooked.empty())
+      AddPhysXDynamicShape(cooked);
+
+  m_CookedCollision.clear();
+  m_CookedCollision.shrink_to_fit();
+}
+
+void Model::CreatePhysXStaticMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices)
+{
+  AddPhysXStaticShape(CookStaticMesh(m_Vertices, m_Indices));
+}
+
+void Model::CreatePhysXMergedStaticMesh()
+{
+  if (m_CookedCollision.size() == 1 && !m_CookedCollision[0].empty())
+    AddPhysXStaticShape(m_CookedCollision[0]);
+  else if (const std::vector<uint8_t> cooked = CookMergedStaticMesh(); !cooked.empty())
+    AddPhysXStaticShape(cooked);
+
+  m_CookedCollision.clear();
+  m_CookedCollision.shrink_to_fit();
+}
+
+void Model::AddPhysXStaticShape(const std::vector<uint8_t>& cooked)
+{
+  PxTriangleMesh* physxMesh = PhysX::CreateTriangleMesh(cooked);
 
   if (!physxMesh) {
       GABGL_ERROR("Failed to create PhysX triangle mesh");
@@ -1365,13 +1853,12 @@ void Model::CreatePhysXStaticMesh(std::vector<Vertex>& m_Vertices, std::vector<G
 
 void Model::CreatePhysXDynamicMesh(std::vector<Vertex>& m_Vertices)
 {
-  std::vector<PxVec3> physxVertices(m_Vertices.size());
-  for (size_t i = 0; i < m_Vertices.size(); ++i)
-  {
-      physxVertices[i] = PxVec3(m_Vertices[i].Position.x, m_Vertices[i].Position.y,m_Vertices[i].Position.z);
-  }
+  AddPhysXDynamicShape(CookDynamicMesh(m_Vertices));
+}
 
-  PxConvexMesh* convexMesh = PhysX::CreateConvexMesh(static_cast<PxU32>(physxVertices.size()), physxVertices.data());
+void Model::AddPhysXDynamicShape(const std::vector<uint8_t>& cooked)
+{
+  PxConvexMesh* convexMesh = PhysX::CreateConvexMesh(cooked);
 
   if (!convexMesh) {
       GABGL_ERROR("Failed to create PhysX convex mesh");
@@ -1423,29 +1910,32 @@ void Model::CreateCharacterController(const PxVec3& position, float radius, floa
   m_ActorController = PhysX::CreateCharacterController(position, radius, height, slopeLimit);
 }
 
-void Model::ExtractBoneWeightForVertices(std::vector<Vertex>& vertices, aiMesh* mesh)
+void Model::RegisterBones(const aiMesh* mesh)
 {
   for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
       std::string boneName = mesh->mBones[i]->mName.C_Str();
-      int boneID = -1;
-
-      if (m_BoneInfoMap.find(boneName) == m_BoneInfoMap.end())
-      {
-          if (m_BoneCounter >= MAX_BONES)
-          {
-              GABGL_ERROR("Model '{}' exceeds the supported limit of {} deforming bones; ignoring '{}'",
-                m_Name, MAX_BONES, boneName);
-              continue;
-          }
+      if (m_BoneInfoMap.contains(boneName))
+          continue;
 
-          boneID = m_BoneCounter++;
-          m_BoneInfoMap[boneName] = { boneID, AssimpMatToGLMMat(mesh->mBones[i]->mOffsetMatrix) };
-      }
-      else
+      if (m_BoneCounter >= MAX_BONES)
       {
-          boneID = m_BoneInfoMap[boneName].id;
+          GABGL_ERROR("Model '{}' exceeds the supported limit of {} deforming bones; ignoring '{}'",
+            m_Name, MAX_BONES, boneName);
+          continue;
       }
 
+      m_BoneInfoMap[boneName] = { m_BoneCounter++, AssimpMatToGLMMat(mesh->mBones[i]->mOffsetMatrix) };
+  }
+}
+
+void Model::ExtractBoneWeightForVertices(std::vector<Vertex>& vertices, const aiMesh* mesh) const
+{
+  for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+      const auto boneIt = m_BoneInfoMap.find(mesh->mBones[i]->mName.C_Str());
+      if (boneIt == m_BoneInfoMap.end())
+          continue;
+
+      const int boneID = boneIt->second.id;
       for (unsigned int j = 0; j < mesh->mBones[i]->mNumWeights; ++j) {
           int vertexID = mesh->mBones[i]->mWeights[j].mVertexId;
           float weight = mesh->mBones[i]->mWeights[j].mWeight;
@@ -1461,7 +1951,7 @@ void Model::ExtractBoneWeightForVertices(std::vector<Vertex>& vertices, aiMesh*
 }
 
 // Set default bone data for a vertex
-void Model::SetDefaultBoneData(Vertex& vertex)
+void Model::SetDefaultBoneData(Vertex& vertex) const
 {
   for (int i = 0; i < MAX_BONE_INFLUENCE; ++i) {
       vertex.m_BoneIDs[i] = -1;
@@ -1470,7 +1960,7 @@ void Model::SetDefaultBoneData(Vertex& vertex)
 }
 
 // Set bone data for a vertex
-void Model::SetBoneData(Vertex& vertex, int boneID, float weight)
+void Model::SetBoneData(Vertex& vertex, int boneID, float weight) const
 {
   if (boneID < 0 || boneID >= MAX_BONES || weight <= 0.0f)
     return;
@@ -1497,7 +1987,7 @@ void Model::SetBoneData(Vertex& vertex, int boneID, float weight)
   }
 }
 
-void Model::NormalizeBoneWeights(Vertex& vertex)
+void Model::NormalizeBoneWeights(Vertex& vertex) const
 {
   float totalWeight = 0.0f;
   for (int i = 0; i < MAX_BONE_INFLUENCE; ++i)
@@ -1514,49 +2004,104 @@ void Model::NormalizeBoneWeights(Vertex& vertex)
 
 void Model::UpdateAnimation(const DeltaTime& dt)
 {
-  if (!m_isAnimated || m_ProcessedAnimations.empty() ||
-      m_CurrentAnimationIndex < 0 ||
-      m_CurrentAnimationIndex >= static_cast<int>(m_ProcessedAnimations.size()))
-    return;
+  for (uint32_t instance = 0; instance < m_Animators.size(); ++instance)
+    UpdateAnimation(instance, dt);
+}
+
+AnimationUpdate Model::UpdateAnimation(uint32_t instance, const DeltaTime& dt)
+{
+  if (!m_isAnimated || instance >= m_Animators.size())
+    return AnimationUpdate::FROZEN;
 
   const float rawDelta = static_cast<float>(dt);
-  const float delta = std::isfinite(rawDelta) && rawDelta > 0.0f ? rawDelta : 0.0f;
+  Animator& animator = m_Animators[instance];
+  animator.m_SkippedTime += std::isfinite(rawDelta) && rawDelta > 0.0f ? rawDelta : 0.0f;
+
+  // Skipped frames only bank their time; the next evaluation plays it all.
+  if (!animator.m_Visible)
+    return AnimationUpdate::FROZEN;
+
+  const bool reduced = animator.m_ProjectedRadius < ANIMATION_LOD_REDUCED_RADIUS;
+  const uint32_t interval = animator.m_ProjectedRadius >= ANIMATION_LOD_FULL_RADIUS ? 1 : reduced ? 4 : 2;
+  if (++animator.m_SkippedFrames < interval)
+    return AnimationUpdate::THROTTLED;
+
+  UpdateAnimator(animator, animator.m_SkippedTime, reduced);
+  animator.m_SkippedFrames = 0;
+  animator.m_SkippedTime = 0.0f;
+  return reduced ? AnimationUpdate::REDUCED : AnimationUpdate::FULL;
+}
+
+void Model::SetAnimationView(uint32_t instance, bool visible, float projectedRadius)
+{
+  if (instance >= m_Animators.size())
+    return;
+
+  m_Animators[instance].m_Visible = visible;
+  m_Animators[instance].m_ProjectedRadius = projectedRadius;
+}
+
+void Model::UpdateAnimator(Animator& animator, float delta, bool reduced) const
+{
+  if (m_ProcessedAnimations.empty() ||
+      animator.m_CurrentAnimationIndex < 0 ||
+      animator.m_CurrentAnimationIndex >= static_cast<int>(m_ProcessedAnimations.size()))
+    return;
 
-  if (!m_IsBlending)
+  if (!animator.m_IsBlending)
   {
-      m_CurrentTime = WrapAnimationTime(m_CurrentTime + m_TicksPerSecond * delta, m_Duration);
+      animator.m_CurrentTime = WrapAnimationTime(animator.m_CurrentTime + animator.m_TicksPerSecond * delta, animator.m_Duration);
 
-      CalculateBoneTransform(&m_RootNode, glm::mat4(1.0f));
+      const AnimationData& animation = m_ProcessedAnimations[animator.m_CurrentAnimationIndex];
+      if (animation.bakedFrames > 1)
+      {
+        SampleBakedPose(animator, animation);
+      }
+      else
+      {
+        animator.m_BakedPalette = nullptr;
+        CalculateBoneTransform(animator, reduced);
+      }
   }
   else
   {
-    m_BlendTime += delta;
-    const float linearBlendFactor = glm::clamp(m_BlendTime / m_BlendDuration, 0.0f, 1.0f);
+    animator.m_BakedPalette = nullptr;
+    animator.m_BlendTime += delta;
+    const float linearBlendFactor = glm::clamp(animator.m_BlendTime / animator.m_BlendDuration, 0.0f, 1.0f);
     const float blendFactor = linearBlendFactor * linearBlendFactor * (3.0f - 2.0f * linearBlendFactor);
 
-    if (!m_BlendFromSnapshot)
-      m_CurrentTime = WrapAnimationTime(m_CurrentTime + m_TicksPerSecond * delta, m_Duration);
-    m_NextTime = WrapAnimationTime(m_NextTime + m_TicksPerSecondNext * delta, m_DurationNext);
+    if (!animator.m_BlendFromSnapshot)
+      animator.m_CurrentTime = WrapAnimationTime(animator.m_CurrentTime + animator.m_TicksPerSecond * delta, animator.m_Duration);
+    animator.m_NextTime = WrapAnimationTime(animator.m_NextTime + animator.m_TicksPerSecondNext * delta, animator.m_DurationNext);
 
-    CalculateBlendedBoneTransform(&m_RootNode, m_CurrentTime, m_NextTime, glm::mat4(1.0f), blendFactor);
+    CalculateBlendedBoneTransform(animator, blendFactor);
 
     if (linearBlendFactor >= 1.0f)
     {
-        const int completedAnimationIndex = m_NextAnimationIndex;
-        const float completedAnimationTime = m_NextTime;
-        SetAnimationbyIndex(completedAnimationIndex);
-        m_CurrentTime = completedAnimationTime;
+        const int completedAnimationIndex = animator.m_NextAnimationIndex;
+        const float completedAnimationTime = animator.m_NextTime;
+        PlayAnimation(animator, completedAnimationIndex);
+        animator.m_CurrentTime = completedAnimationTime;
     }
   }
 }
 
 bool Model::IsInAnimation(int index) const
+{
+  return IsInAnimation(0u, index);
+}
+
+bool Model::IsInAnimation(uint32_t instance, int index) const
 {
   if (index < 0 || index >= static_cast<int>(m_ProcessedAnimations.size()))
     return false;
 
-  return (!m_IsBlending && m_CurrentAnimationIndex == index) ||
-         (m_IsBlending && m_NextAnimationIndex == index);
+  if (instance >= m_Animators.size())
+    return m_CurrentAnimationIndex == index;
+
+  const Animator& animator = m_Animators[instance];
+  return (!animator.m_IsBlending && animator.m_CurrentAnimationIndex == index) ||
+         (animator.m_IsBlending && animator.m_NextAnimationIndex == index);
 }
 
 void Model::StartBlendToAnimation(int32_t nextAnimationIndex, float blendDuration)
@@ -1568,37 +2113,66 @@ void Model::StartBlendToAnimation(int32_t nextAnimationIndex, float blendDuratio
     return;
   }
 
-  if (IsInAnimation(nextAnimationIndex))
+  for (Animator& animator : m_Animators)
+    BlendToAnimation(animator, nextAnimationIndex, blendDuration);
+}
+
+void Model::StartBlendToAnimation(uint32_t instance, int32_t nextAnimationIndex, float blendDuration)
+{
+  if (nextAnimationIndex < 0 ||
+      nextAnimationIndex >= static_cast<int32_t>(m_ProcessedAnimations.size()))
+  {
+    GABGL_ERROR("Invalid animation index {} for model '{}'", nextAnimationIndex, m_Name);
+    return;
+  }
+
+  if (instance < m_Animators.size())
+    BlendToAnimation(m_Animators[instance], nextAnimationIndex, blendDuration);
+}
+
+void Model::BlendToAnimation(Animator& animator, int32_t nextAnimationIndex, float blendDuration) const
+{
+  if ((!animator.m_IsBlending && animator.m_CurrentAnimationIndex == nextAnimationIndex) ||
+      (animator.m_IsBlending && animator.m_NextAnimationIndex == nextAnimationIndex))
     return;
 
   if (!std::isfinite(blendDuration) ||
-      blendDuration <= std::numeric_limits<float>::epsilon())
+      blendDuration <= std::numeric_limits<float>::epsilon() ||
+      animator.m_CurrentAnimationIndex < 0)
   {
-    SetAnimationbyIndex(nextAnimationIndex);
+    PlayAnimation(animator, nextAnimationIndex);
     return;
   }
 
-  std::unordered_map<std::string, glm::mat4> interruptedPose;
-  if (m_IsBlending)
+  // An interrupted blend becomes the source pose of the new one, captured
+  // in place: node i only reads its own snapshot entry.
+  const bool interrupted = animator.m_IsBlending;
+  if (interrupted)
   {
-    const float linearFactor = glm::clamp(m_BlendTime / m_BlendDuration, 0.0f, 1.0f);
+    const float linearFactor = glm::clamp(animator.m_BlendTime / animator.m_BlendDuration, 0.0f, 1.0f);
     const float smoothFactor = linearFactor * linearFactor * (3.0f - 2.0f * linearFactor);
-    interruptedPose.reserve(m_BlendSourcePose.size() + m_BoneInfoMap.size());
-    CaptureBlendedLocalPose(&m_RootNode, smoothFactor, interruptedPose);
+    CaptureBlendedLocalPose(animator, smoothFactor, animator.m_BlendSourcePose);
+  }
+  else
+  {
+    animator.m_BlendSourcePose.clear();
   }
 
-  m_BlendTime = 0.0f;
-  m_BlendDuration = std::max(blendDuration, std::numeric_limits<float>::epsilon());
-  m_IsBlending = true;
-  m_BlendFromSnapshot = !interruptedPose.empty();
-  m_BlendSourcePose = std::move(interruptedPose);
-  m_NextAnimationIndex = nextAnimationIndex;
-  m_NextTime = 0.0f;
+  animator.m_BlendTime = 0.0f;
+  animator.m_BlendDuration = std::max(blendDuration, std::numeric_limits<float>::epsilon());
+  animator.m_IsBlending = true;
+  animator.m_BlendFromSnapshot = interrupted;
+  animator.m_NextAnimationIndex = nextAnimationIndex;
+  animator.m_NextTime = 0.0f;
 
   const AnimationData& animData = m_ProcessedAnimations[nextAnimationIndex];
-  m_BonesNext           = animData.bones;
-  m_TicksPerSecondNext  = animData.ticksPerSecond;
-  m_DurationNext        = animData.duration;
+  animator.m_TicksPerSecondNext = std::isfinite(animData.ticksPerSecond) && animData.ticksPerSecond > 0.0f
+    ? animData.ticksPerSecond
+    : 25.0f;
+  animator.m_DurationNext = std::isfinite(animData.duration) &&
+                            animData.duration > std::numeric_limits<float>::epsilon()
+    ? animData.duration
+    : 1.0f;
 }
 
 void Model::SetAnimationbyIndex(int animationIndex)
@@ -1610,12 +2184,6 @@ void Model::SetAnimationbyIndex(int animationIndex)
   }
 
   m_CurrentAnimationIndex = animationIndex;
-  m_CurrentTime = 0.0f;
-  m_IsBlending = false;
-  m_BlendFromSnapshot = false;
-  m_BlendSourcePose.clear();
-  m_NextAnimationIndex = -1;
-  m_NextTime = 0.0f;
   
   const AnimationData& animData = m_ProcessedAnimations[animationIndex];
 
@@ -1627,10 +2195,57 @@ void Model::SetAnimationbyIndex(int animationIndex)
     ? animData.ticksPerSecond
     : 25.0f;
 
-  m_RootNode = animData.hierarchy;
-  m_Bones = animData.bones;
+  for (Animator& animator : m_Animators)
+    PlayAnimation(animator, animationIndex);
+}
+
+void Model::SetAnimationbyIndex(uint32_t instance, int animationIndex)
+{
+  if (animationIndex < 0 || animationIndex >= static_cast<int>(m_ProcessedAnimations.size()))
+  {
+    GABGL_ERROR("Invalid animation index {} for model '{}'", animationIndex, m_Name);
+    return;
+  }
 
-  ResizeFinalBoneMatrices();
+  if (instance < m_Animators.size())
+    PlayAnimation(m_Animators[instance], animationIndex);
+}
+
+void Model::PlayAnimation(Animator& animator, int animationIndex) const
+{
+  animator.m_CurrentAnimationIndex = animationIndex;
+  animator.m_BakedPalette = nullptr;
+  animator.m_CurrentTime = 0.0f;
+  animator.m_IsBlending = false;
+  animator.m_BlendFromSnapshot = false;
+  animator.m_BlendSourcePose.clear();
+  animator.m_NextAnimationIndex = -1;
+  animator.m_NextTime = 0.0f;
+
+  const AnimationData& animData = m_ProcessedAnimations[animationIndex];
+  animator.m_Duration = std::isfinite(animData.duration) &&
+                        animData.duration > std::numeric_limits<float>::epsilon()
+    ? animData.duration
+    : 1.0f;
+  animator.m_TicksPerSecond = std::isfinite(animData.ticksPerSecond) && animData.ticksPerSecond > 0.0f
+    ? animData.ticksPerSecond
+    : 25.0f;
+}
+
+void Model::ResizeAnimators(size_t count)
+{
+  const size_t previous = m_Animators.size();
+  m_Animators.resize(count);
+  for (size_t i = previous; i < count; ++i)
+  {
+    Animator& animator = m_Animators[i];
+    // Staggered, so throttled instances do not all evaluate on one frame.
+    animator.m_SkippedFrames = static_cast<uint32_t>(i % 4);
+    animator.m_GlobalPose.assign(m_Skeleton.size(), glm::mat4(1.0f));
+    animator.m_FinalBoneMatrices.assign(MAX_BONES, glm::mat4(1.0f));
+    if (m_CurrentAnimationIndex >= 0 && m_CurrentAnimationIndex < static_cast<int>(m_ProcessedAnimations.size()))
+      PlayAnimation(animator, m_CurrentAnimationIndex);
+  }
 }
 
 void Model::SetAnimationByName(const std::string& animationName)
@@ -1648,101 +2263,206 @@ void Model::SetAnimationByName(const std::string& animationName)
   }
 }
 
-void Model::CalculateBoneTransform(const AssimpNodeData* node, const glm::mat4& parentTransform)
+void Model::BuildSkeleton()
 {
-  const std::string& nodeName = node->name;
-  const glm::mat4 nodeTransform = SampleLocalTransform(*node, m_Bones, m_CurrentTime);
+  m_Skeleton.clear();
+  m_PaletteBoneCount = 0;
+  if (m_ProcessedAnimations.empty())
+    return;
 
-  const glm::mat4 globalTransformation = parentTransform * nodeTransform;
+  // Every clip is read from the same scene root. Pre-order walk: parents
+  // land before children.
+  std::vector<const AssimpNodeData*> sources;
+  std::vector<uint32_t> depths;
+  std::vector<std::pair<const AssimpNodeData*, int32_t>> stack{ { &m_RootNode, -1 } };
+  while (!stack.empty())
+  {
+    const auto [source, parent] = stack.back();
+    stack.pop_back();
+
+    const int32_t index = static_cast<int32_t>(m_Skeleton.size());
+    SkeletonNode& node = m_Skeleton.emplace_back();
+    node.transformation = source->transformation;
+    node.bindPose = TransformTRS::FromMat4(source->transformation);
+    node.parent = parent;
+    if (const auto it = m_BoneInfoMap.find(source->name); it != m_BoneInfoMap.end() &&
+        it->second.id >= 0 && it->second.id < MAX_BONES)
+    {
+      node.palette = it->second.id;
+      node.offset = it->second.offset;
+      m_PaletteBoneCount = std::max(m_PaletteBoneCount, static_cast<uint32_t>(node.palette + 1));
+    }
+    sources.push_back(source);
+    depths.push_back(parent < 0 ? 0 : depths[parent] + 1);
 
-  auto it = m_BoneInfoMap.find(nodeName);
-  if (it != m_BoneInfoMap.end())
-  {
-      const int index = it->second.id;
-      if (index >= 0 && index < static_cast<int>(m_FinalBoneMatrices.size()))
-        m_FinalBoneMatrices[index] = m_GlobalInverseTransform * globalTransformation * it->second.offset;
+    for (auto child = source->children.rbegin(); child != source->children.rend(); ++child)
+      stack.emplace_back(&*child, index);
   }
 
-  for (const auto & i : node->children)
-      CalculateBoneTransform(&i, globalTransformation);
-}
+  for (AnimationData& animation : m_ProcessedAnimations)
+  {
+    std::unordered_map<std::string, int32_t> tracks;
+    tracks.reserve(animation.bones.size());
+    for (size_t i = 0; i < animation.bones.size(); ++i)
+      tracks.emplace(animation.bones[i].GetBoneName(), static_cast<int32_t>(i));
 
-glm::mat4 Model::SampleLocalTransform(const AssimpNodeData& node, const std::vector<Bone>& bones,
-  float animationTime) const
-{
-  if (const Bone* bone = FindBoneInList(node.name, bones))
-    return bone->GetInterpolatedTransform(animationTime, node.transformation);
-  return node.transformation;
+    std::vector<int32_t> boneNodes(animation.bones.size(), -1);
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      if (const auto it = tracks.find(sources[i]->name); it != tracks.end())
+        boneNodes[it->second] = static_cast<int32_t>(i);
+    }
+
+    // Tracks go shallowest node first, so the reduced bone set of distant
+    // instances is a prefix; bones without a node go last.
+    const auto depthOf = [&](size_t bone) {
+      return boneNodes[bone] >= 0 ? depths[boneNodes[bone]] : std::numeric_limits<uint32_t>::max();
+    };
+    std::vector<size_t> order(animation.bones.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::ranges::stable_sort(order, {}, depthOf);
+
+    animation.nodeTracks.assign(sources.size(), -1);
+    animation.reducedTrackCount = 0;
+    std::vector<const Bone*> orderedBones;
+    std::vector<TransformTRS> bindPoses;
+    orderedBones.reserve(order.size());
+    bindPoses.reserve(order.size());
+    for (const size_t bone : order)
+    {
+      const int32_t node = boneNodes[bone];
+      if (node >= 0)
+        animation.nodeTracks[node] = static_cast<int32_t>(orderedBones.size());
+      if (depthOf(bone) <= ANIMATION_LOD_REDUCED_DEPTH)
+        ++animation.reducedTrackCount;
+      orderedBones.push_back(&animation.bones[bone]);
+      bindPoses.push_back(node >= 0 ? m_Skeleton[node].bindPose : TransformTRS{});
+    }
+    animation.tracks = AnimationSampler::Build(orderedBones, bindPoses);
+
+    GABGL_INFO("Animation '{}': {} -> {} keys, {:.1f} -> {:.1f} KB", animation.name, animation.tracks.sourceKeys,
+      animation.tracks.GetKeyCount(), animation.tracks.sourceSize / 1024.0f, animation.tracks.GetSize() / 1024.0f);
+  }
 }
 
-void Model::CaptureBlendedLocalPose(const AssimpNodeData* node, float blendFactor,
-  std::unordered_map<std::string, glm::mat4>& outPose) const
+void Model::CalculateBoneTransform(Animator& animator, bool reduced) const
 {
-  const std::string& nodeName = node->name;
-  glm::mat4 transformCurrent;
-  if (m_BlendFromSnapshot)
+  const AnimationData& animation = m_ProcessedAnimations[animator.m_CurrentAnimationIndex];
+  const size_t trackCount = reduced ? animation.reducedTrackCount : animation.tracks.GetTrackCount();
+  AnimationSampler::Sample(animation.tracks, animator.m_CurrentTime, animator.m_TrackCursors, animator.m_LocalPose,
+    trackCount);
+  for (size_t i = 0; i < m_Skeleton.size(); ++i)
   {
-    const auto snapshotIt = m_BlendSourcePose.find(nodeName);
-    transformCurrent = snapshotIt != m_BlendSourcePose.end()
-      ? snapshotIt->second
-      : SampleLocalTransform(*node, m_Bones, m_CurrentTime);
+    // Nodes past the reduced set keep their bind pose.
+    const int32_t track = animation.nodeTracks[i];
+    StoreGlobalTransform(animator, i, track >= 0 && static_cast<size_t>(track) < trackCount
+      ? animator.m_LocalPose[track].ToMat4()
+      : m_Skeleton[i].transformation);
   }
-  else
+}
+
+void Model::BakeAnimationPoses(float frameRate)
+{
+  if (!m_isAnimated || m_Skeleton.empty() || !std::isfinite(frameRate) || frameRate <= 0.0f)
+    return;
+
+  // Clips are independent; each one samples through its own animator.
+  JobSystem::ParallelFor(m_ProcessedAnimations.size(), 1, [this, frameRate](size_t begin, size_t end)
   {
-    transformCurrent = SampleLocalTransform(*node, m_Bones, m_CurrentTime);
-  }
+    for (size_t index = begin; index < end; ++index)
+    {
+      Animator animator;
+      animator.m_GlobalPose.assign(m_Skeleton.size(), glm::mat4(1.0f));
+      animator.m_FinalBoneMatrices.assign(MAX_BONES, glm::mat4(1.0f));
+      PlayAnimation(animator, static_cast<int>(index));
+
+      // Whole frames over the clip, so the last frame lands on its end.
+      const float seconds = animator.m_Duration / animator.m_TicksPerSecond;
+      const uint32_t intervals = std::max(1u, static_cast<uint32_t>(std::ceil(seconds * frameRate)));
+
+      AnimationData& animation = m_ProcessedAnimations[index];
+      animation.bakedFrames = intervals + 1;
+      animation.bakedPalettes.resize(static_cast<size_t>(animation.bakedFrames) * m_PaletteBoneCount);
+      for (uint32_t frame = 0; frame < animation.bakedFrames; ++frame)
+      {
+        animator.m_CurrentTime = animator.m_Duration * static_cast<float>(frame) / static_cast<float>(intervals);
+        CalculateBoneTransform(animator);
+        std::copy_n(animator.m_FinalBoneMatrices.begin(), m_PaletteBoneCount,
+          animation.bakedPalettes.begin() + static_cast<size_t>(frame) * m_PaletteBoneCount);
+      }
+    }
+  });
 
-  const glm::mat4 transformNext = SampleLocalTransform(*node, m_BonesNext, m_NextTime);
-  outPose[nodeName] = BlendLocalTransforms(transformCurrent, transformNext, blendFactor);
+  for (const AnimationData& animation : m_ProcessedAnimations)
+    GABGL_INFO("Animation '{}': baked {} frames at {} fps, {:.1f} KB", animation.name, animation.bakedFrames,
+      frameRate, animation.bakedPalettes.size() * sizeof(glm::mat4) / 1024.0f);
+}
 
-  for (const AssimpNodeData& child : node->children)
-    CaptureBlendedLocalPose(&child, blendFactor, outPose);
+void Model::SampleBakedPose(Animator& animator, const AnimationData& animation) const
+{
+  const float frame = animator.m_CurrentTime / animator.m_Duration * static_cast<float>(animation.bakedFrames - 1);
+#if ANIMATION_BAKED_LERP
+  const uint32_t first = std::min(static_cast<uint32_t>(frame), animation.bakedFrames - 2);
+  const float t = glm::clamp(frame - static_cast<float>(first), 0.0f, 1.0f);
+  const glm::mat4* from = animation.bakedPalettes.data() + static_cast<size_t>(first) * m_PaletteBoneCount;
+  const glm::mat4* to = from + m_PaletteBoneCount;
+  for (uint32_t i = 0; i < m_PaletteBoneCount; ++i)
+    animator.m_FinalBoneMatrices[i] = from[i] + (to[i] - from[i]) * t;
+  animator.m_BakedPalette = nullptr;
+#else
+  const uint32_t nearest = std::min(static_cast<uint32_t>(std::lround(frame)), animation.bakedFrames - 1);
+  animator.m_BakedPalette = animation.bakedPalettes.data() + static_cast<size_t>(nearest) * m_PaletteBoneCount;
+#endif
 }
 
-void Model::CalculateBlendedBoneTransform(const AssimpNodeData* node, float timeCurrent,
-  float timeNext, const glm::mat4& parentTransform, float blendFactor)
+void Model::CalculateBlendedBoneTransform(Animator& animator, float blendFactor) const
 {
-  const std::string& nodeName = node->name;
-  glm::mat4 transformCurrent;
-  if (m_BlendFromSnapshot)
-  {
-    const auto snapshotIt = m_BlendSourcePose.find(nodeName);
-    transformCurrent = snapshotIt != m_BlendSourcePose.end()
-      ? snapshotIt->second
-      : SampleLocalTransform(*node, m_Bones, timeCurrent);
-  }
-  else
-  {
-    transformCurrent = SampleLocalTransform(*node, m_Bones, timeCurrent);
-  }
+  SampleBlendSources(animator);
+  for (size_t i = 0; i < m_Skeleton.size(); ++i)
+    StoreGlobalTransform(animator, i, GetBlendedLocalTransform(animator, i, blendFactor).ToMat4());
+}
+
+void Model::CaptureBlendedLocalPose(Animator& animator, float blendFactor, std::vector<TransformTRS>& outPose) const
+{
+  SampleBlendSources(animator);
+  outPose.resize(m_Skeleton.size());
+  for (size_t i = 0; i < m_Skeleton.size(); ++i)
+    outPose[i] = GetBlendedLocalTransform(animator, i, blendFactor);
+}
 
-  const glm::mat4 transformNext = SampleLocalTransform(*node, m_BonesNext, timeNext);
-  const glm::mat4 blendedTransform = BlendLocalTransforms(transformCurrent, transformNext, blendFactor);
-  const glm::mat4 globalTransform = parentTransform * blendedTransform;
+void Model::SampleBlendSources(Animator& animator) const
+{
+  if (!animator.m_BlendFromSnapshot)
+    AnimationSampler::Sample(m_ProcessedAnimations[animator.m_CurrentAnimationIndex].tracks, animator.m_CurrentTime,
+      animator.m_TrackCursors, animator.m_BlendPose);
+  AnimationSampler::Sample(m_ProcessedAnimations[animator.m_NextAnimationIndex].tracks, animator.m_NextTime,
+    animator.m_TrackCursorsNext, animator.m_BlendPoseNext);
+}
 
-  if (const auto it = m_BoneInfoMap.find(nodeName); it != m_BoneInfoMap.end())
-  {
-      const int index = it->second.id;
-      if (index >= 0 && index < static_cast<int>(m_FinalBoneMatrices.size()))
-        m_FinalBoneMatrices[index] = m_GlobalInverseTransform * globalTransform * it->second.offset;
-  }
+void Model::StoreGlobalTransform(Animator& animator, size_t node, const glm::mat4& localTransform) const
+{
+  const SkeletonNode& skeletonNode = m_Skeleton[node];
+  animator.m_GlobalPose[node] = skeletonNode.parent < 0
+    ? localTransform
+    : animator.m_GlobalPose[skeletonNode.parent] * localTransform;
 
-  for (const AssimpNodeData& child : node->children)
-    CalculateBlendedBoneTransform(&child, timeCurrent, timeNext, globalTransform, blendFactor);
+  if (skeletonNode.palette >= 0)
+    animator.m_FinalBoneMatrices[skeletonNode.palette] = m_GlobalInverseTransform * animator.m_GlobalPose[node] * skeletonNode.offset;
 }
 
-const Bone* Model::FindBoneInList(const std::string& name, const std::vector<Bone>& bones) const
+TransformTRS Model::GetLocalTransform(size_t node, int animationIndex, const std::vector<TransformTRS>& localPose) const
 {
-  auto iter = std::ranges::find_if(bones,
-                                   [&](const Bone& bone) {
-                                     return bone.GetBoneName() == name;
-                                   });
-  return iter != bones.end() ? &(*iter) : nullptr;
+  const int32_t track = m_ProcessedAnimations[animationIndex].nodeTracks[node];
+  return track >= 0 ? localPose[track] : m_Skeleton[node].bindPose;
 }
 
-void Model::ResizeFinalBoneMatrices()
+TransformTRS Model::GetBlendedLocalTransform(const Animator& animator, size_t node, float blendFactor) const
 {
-  m_FinalBoneMatrices.resize(MAX_BONES, glm::mat4(1.0f));
+  const TransformTRS& transformCurrent = animator.m_BlendFromSnapshot
+    ? animator.m_BlendSourcePose[node]
+    : GetLocalTransform(node, animator.m_CurrentAnimationIndex, animator.m_BlendPose);
+  const TransformTRS transformNext = GetLocalTransform(node, animator.m_NextAnimationIndex, animator.m_BlendPoseNext);
+  return TransformTRS::Blend(transformCurrent, transformNext, blendFactor);
 }
 
 void Model::ReadHierarchyData(AssimpNodeData& dest, const aiNode* src)
@@ -1771,12 +2491,12 @@ void Model::ReadHierarchyData(AssimpNodeData& dest, const aiNode* src)
   }
 }
 
-void Model::ReadMissingBones(const aiAnimation* animation)
+void Model::ReadMissingBones(const aiAnimation* animation, std::vector<Bone>& bones)
 {
   assert(animation);  
 
-  m_Bones.clear();
-  m_Bones.reserve(animation->mNumChannels);
+  bones.clear();
+  bones.reserve(animation->mNumChannels);
 
   for (unsigned int i = 0; i < animation->mNumChannels; i++)
   {
@@ -1784,7 +2504,7 @@ void Model::ReadMissingBones(const aiAnimation* animation)
       const std::string boneName = channel->mNodeName.data;
       const auto boneInfoIt = m_BoneInfoMap.find(boneName);
       const int boneId = boneInfoIt != m_BoneInfoMap.end() ? boneInfoIt->second.id : -1;
-      m_Bones.emplace_back(boneName, boneId, channel);
+      bones.emplace_back(boneName, boneId, channel);
   }
 }
 
@@ -1833,32 +2553,21 @@ Bone::Bone(const std::string& name, int ID, const aiNodeAnim* channel) : m_Name(
   }
 }
 
-glm::mat4 Bone::GetInterpolatedTransform(float animationTime, const glm::mat4& fallbackTransform) const
+Bone::Bone(const std::string& name, int ID, std::vector<KeyPosition> positions,
+  std::vector<KeyRotation> rotations, std::vector<KeyScale> scales)
+  : m_Positions(std::move(positions)), m_Rotations(std::move(rotations)), m_Scales(std::move(scales)),
+    m_Name(name), m_ID(ID)
 {
-  glm::vec3 fallbackScale(1.0f);
-  glm::quat fallbackRotation(1.0f, 0.0f, 0.0f, 0.0f);
-  glm::vec3 fallbackTranslation(0.0f);
-  glm::vec3 skew(0.0f);
-  glm::vec4 perspective(0.0f);
-  if (!glm::decompose(fallbackTransform, fallbackScale, fallbackRotation,
-      fallbackTranslation, skew, perspective))
-  {
-    fallbackScale = glm::vec3(1.0f);
-    fallbackRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-    fallbackTranslation = glm::vec3(0.0f);
-  }
-
-  const glm::mat4 translation = m_NumPositions > 0
-    ? InterpolatePosition(animationTime)
-    : glm::translate(glm::mat4(1.0f), fallbackTranslation);
-  const glm::mat4 rotation = m_NumRotations > 0
-    ? InterpolateRotation(animationTime)
-    : glm::toMat4(glm::normalize(fallbackRotation));
-  const glm::mat4 scale = m_NumScalings > 0
-    ? InterpolateScaling(animationTime)
-    : glm::scale(glm::mat4(1.0f), fallbackScale);
+  m_NumPositions = static_cast<int>(m_Positions.size());
+  m_NumRotations = static_cast<int>(m_Rotations.size());
+  m_NumScalings = static_cast<int>(m_Scales.size());
+}
 
-  return translation * rotation * scale;
+TransformTRS Bone::GetInterpolatedTransform(float animationTime, const TransformTRS& bindPose, Cursors& cursors) const
+{
+  return { m_NumPositions > 0 ? InterpolatePosition(animationTime, cursors.position) : bindPose.translation,
+           m_NumRotations > 0 ? InterpolateRotation(animationTime, cursors.rotation) : bindPose.rotation,
+           m_NumScalings > 0 ? InterpolateScaling(animationTime, cursors.scale) : bindPose.scale };
 }
 
 // Interpolation helper functions
@@ -1872,97 +2581,54 @@ float Bone::GetScaleFactor(float lastTimeStamp, float nextTimeStamp, float anima
     return glm::clamp(scaleFactor, 0.0f, 1.0f);
 }
 
-glm::mat4 Bone::InterpolatePosition(float animationTime) const
+glm::vec3 Bone::InterpolatePosition(float animationTime, int& cursor) const
 {
     if (m_NumPositions == 0)
-        return glm::mat4(1.0f);
+        return glm::vec3(0.0f);
 
     if (m_NumPositions == 1) {
-        return glm::translate(glm::mat4(1.0f), m_Positions[0].position);
+        return m_Positions[0].position;
     }
 
-    int p0Index = GetPositionIndex(animationTime);
+    int p0Index = FindKeyIndex(m_Positions, animationTime, cursor);
     int p1Index = p0Index + 1;
 
     float scaleFactor = GetScaleFactor(m_Positions[p0Index].timeStamp, m_Positions[p1Index].timeStamp, animationTime);
-    glm::vec3 finalPosition = glm::mix(m_Positions[p0Index].position, m_Positions[p1Index].position, scaleFactor);
-
-    return glm::translate(glm::mat4(1.0f), finalPosition);
+    return glm::mix(m_Positions[p0Index].position, m_Positions[p1Index].position, scaleFactor);
 }
 
-glm::mat4 Bone::InterpolateRotation(float animationTime) const
+glm::quat Bone::InterpolateRotation(float animationTime, int& cursor) const
 {
     if (m_NumRotations == 0)
-        return glm::mat4(1.0f);
+        return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
 
     if (m_NumRotations == 1) {
-        return glm::toMat4(glm::normalize(m_Rotations[0].orientation));
+        return glm::normalize(m_Rotations[0].orientation);
     }
 
-    int p0Index = GetRotationIndex(animationTime);
+    int p0Index = FindKeyIndex(m_Rotations, animationTime, cursor);
     int p1Index = p0Index + 1;
 
     float scaleFactor = GetScaleFactor(m_Rotations[p0Index].timeStamp, m_Rotations[p1Index].timeStamp, animationTime);
     glm::quat finalRotation = glm::slerp(m_Rotations[p0Index].orientation, m_Rotations[p1Index].orientation, scaleFactor);
 
-    return glm::toMat4(glm::normalize(finalRotation));
+    return glm::normalize(finalRotation);
 }
 
-glm::mat4 Bone::InterpolateScaling(float animationTime) const
+glm::vec3 Bone::InterpolateScaling(float animationTime, int& cursor) const
 {
     if (m_NumScalings == 0)
-        return glm::mat4(1.0f);
+        return glm::vec3(1.0f);
 
     if (m_NumScalings == 1) {
-        return glm::scale(glm::mat4(1.0f), m_Scales[0].scale);
+        return m_Scales[0].scale;
     }
 
-    int p0Index = GetScaleIndex(animationTime);
+    int p0Index = FindKeyIndex(m_Scales, animationTime, cursor);
     int p1Index = p0Index + 1;
 
     float scaleFactor = GetScaleFactor(m_Scales[p0Index].timeStamp, m_Scales[p1Index].timeStamp, animationTime);
-    glm::vec3 finalScale = glm::mix(m_Scales[p0Index].scale, m_Scales[p1Index].scale, scaleFactor);
-
-    return glm::scale(glm::mat4(1.0f), finalScale);
-}
-
-int Bone::GetPositionIndex(float animationTime) const
-{
-    if (m_NumPositions <= 1)
-        return 0;
-
-    for (int i = 0; i < m_NumPositions - 1; ++i) {
-        if (animationTime < m_Positions[i + 1].timeStamp) {
-            return i;
-        }
-    }
-    return m_NumPositions - 2;
-}
-
-int Bone::GetRotationIndex(float animationTime) const
-{
-    if (m_NumRotations <= 1)
-        return 0;
-
-    for (int i = 0; i < m_NumRotations - 1; ++i) {
-        if (animationTime < m_Rotations[i + 1].timeStamp) {
-            return i;
-        }
-    }
-    return m_NumRotations - 2;
-}
-
-int Bone::GetScaleIndex(float animationTime) const
-{
-    if (m_NumScalings <= 1)
-        return 0;
-
-    for (int i = 0; i < m_NumScalings - 1; ++i) {
-        if (animationTime < m_Scales[i + 1].timeStamp) {
-            return i;
-        }
-    }
-    return m_NumScalings - 2;
+    return glm::mix(m_Scales[p0Index].scale, m_Scales[p1Index].scale, scaleFactor);
 }
 
 
@@ -11,6 +11,8 @@
 #include <assimp/matrix4x4.h>
 #include <meshoptimizer.h>
 
+#include <algorithm>
+#include <array>
 #include <unordered_map>
 #include <map>
 
@@ -18,9 +20,46 @@
 #include "DeltaTime.hpp"
 #include "PhysX.h"
 #include "Transform.hpp"
+#include "AnimationSampler.h"
 
 #define MAX_BONE_INFLUENCE 4
 #define MAX_BONES 100
+// Detail levels baked per mesh; LOD 0 is the full OptimizeMesh result.
+#define MESH_LOD_COUNT 4
+// Upload the shared VBO as PackedVertex (32 bytes) instead of Vertex.
+#define PACKED_VERTICES 1
+// Meshlet limits for meshopt_buildMeshlets; only LOD 0 of static meshes
+// with at least MESHLET_MIN_TRIANGLES triangles is split. Skinned meshes
+// are not: their bounds and normal cones would only hold in the bind pose.
+#define MESHLET_MAX_VERTICES 64
+#define MESHLET_MAX_TRIANGLES 124
+#define MESHLET_MIN_TRIANGLES 1024
+// Convex collision proxy: meshes are grouped into at most
+// CONVEX_HULL_MAX_COUNT hulls of at most CONVEX_HULL_VERTEX_LIMIT vertices.
+// Input points are welded on a CONVEX_HULL_WELD_CELLS^3 grid over the model
+// bounds and quantized to CONVEX_HULL_QUANTIZED_COUNT before hull building.
+#define CONVEX_HULL_MAX_COUNT 4
+#define CONVEX_HULL_VERTEX_LIMIT 32
+#define CONVEX_HULL_WELD_CELLS 256
+#define CONVEX_HULL_QUANTIZED_COUNT 255
+// Animation key reduction: a key is dropped when interpolating its
+// neighbours reproduces it within these bounds. Rotation in radians,
+// translation as a fraction of the bone's length, scale absolute.
+#define ANIMATION_ROTATION_TOLERANCE 0.0005f
+#define ANIMATION_POSITION_TOLERANCE 0.0005f
+#define ANIMATION_SCALE_TOLERANCE 0.0005f
+// Baked pose cache (Model::BakeAnimationPoses): lerp between the two baked
+// frames around the playback time, or share the nearest frame as is.
+#define ANIMATION_BAKED_LERP 1
+// Animation LOD from an instance's projected radius in the last culling pass
+// (1.0 = half the screen height): every frame at or above
+// ANIMATION_LOD_FULL_RADIUS, every 2nd frame above
+// ANIMATION_LOD_REDUCED_RADIUS, and below it every 4th frame with only the
+// nodes up to ANIMATION_LOD_REDUCED_DEPTH deep animated. Instances outside
+// the frustum are not evaluated at all.
+#define ANIMATION_LOD_FULL_RADIUS 0.1f
+#define ANIMATION_LOD_REDUCED_RADIUS 0.04f
+#define ANIMATION_LOD_REDUCED_DEPTH 8
 
 struct KeyPosition {
     glm::vec3 position;
@@ -40,20 +79,40 @@ struct KeyScale {
 struct Bone
 {
   Bone(const std::string& name, int ID, const aiNodeAnim* channel);
-
-  glm::mat4 GetInterpolatedTransform(float animationTime, const glm::mat4& fallbackTransform) const;
-
-  inline std::string GetBoneName() const { return m_Name; }
+  Bone(const std::string& name, int ID, std::vector<KeyPosition> positions,
+    std::vector<KeyRotation> rotations, std::vector<KeyScale> scales);
+
+  // Playback cursors of FindKeyIndex, one per track. Owned by the caller:
+  // clips are shared and immutable, so the bone keeps no playback state.
+  struct Cursors
+  {
+    int position = 0;
+    int rotation = 0;
+    int scale = 0;
+  };
+
+  // Channels without keys take their value from `bindPose`.
+  TransformTRS GetInterpolatedTransform(float animationTime, const TransformTRS& bindPose, Cursors& cursors) const;
+
+  inline const std::string& GetBoneName() const { return m_Name; }
   inline int GetBoneID() const { return m_ID; }
+  inline const std::vector<KeyPosition>& GetPositionKeys() const { return m_Positions; }
+  inline const std::vector<KeyRotation>& GetRotationKeys() const { return m_Rotations; }
+  inline const std::vector<KeyScale>& GetScaleKeys() const { return m_Scales; }
+
+  // Key search over one of the tracks above; see ::FindKeyIndex.
+  template<typename Key>
+  static int FindKeyIndex(const std::vector<Key>& keys, float animationTime, int& cursor)
+  {
+    return ::FindKeyIndex(static_cast<int>(keys.size()), animationTime, cursor,
+      [&keys](int i) { return keys[i].timeStamp; });
+  }
 
 private:
   float GetScaleFactor(float lastTimeStamp, float nextTimeStamp, float animationTime) const;
-  glm::mat4 InterpolatePosition(float animationTime) const;
-  glm::mat4 InterpolateRotation(float animationTime) const;
-  glm::mat4 InterpolateScaling(float animationTime) const;
-  int GetPositionIndex(float animationTime) const;
-  int GetRotationIndex(float animationTime) const;
-  int GetScaleIndex(float animationTime) const;
+  glm::vec3 InterpolatePosition(float animationTime, int& cursor) const;
+  glm::quat InterpolateRotation(float animationTime, int& cursor) const;
+  glm::vec3 InterpolateScaling(float animationTime, int& cursor) const;
 
   std::vector<KeyPosition> m_Positions;
   std::vector<KeyRotation> m_Rotations;
@@ -81,13 +140,89 @@ struct AssimpNodeData
   std::vector<AssimpNodeData> children;
 };
 
+// One node of Model::m_Skeleton, the node hierarchy flattened in depth-first
+// order so that a parent always comes before its children.
+struct SkeletonNode
+{
+  glm::mat4 transformation = glm::mat4(1.0f); // local transform when a clip has no track for the node
+  TransformTRS bindPose;                       // `transformation`, decomposed once at load
+  glm::mat4 offset = glm::mat4(1.0f);         // offset matrix of the palette bone
+  int32_t parent = -1;
+  int32_t palette = -1; // index into the final bone matrices, -1 for unskinned nodes
+};
+
 struct AnimationData
 {
   std::string name;
   float duration = 1.0f;
   float ticksPerSecond = 25.0f;
-  std::vector<Bone> bones;  // Preprocessed bone data for the animation.
-  AssimpNodeData hierarchy; // Precomputed node hierarchy for the animation.
+  std::vector<Bone> bones; // Preprocessed bone data for the animation.
+  // Per skeleton node, the index of its track in `tracks` or -1. Resolved
+  // by Model::BuildSkeleton, not cached.
+  std::vector<int32_t> nodeTracks;
+  // `bones` repacked for AnimationSampler, also built by Model::BuildSkeleton.
+  // Tracks are ordered by node depth; the first `reducedTrackCount` animate
+  // the nodes up to ANIMATION_LOD_REDUCED_DEPTH deep.
+  AnimationTracks tracks;
+  uint32_t reducedTrackCount = 0;
+  // Final bone palettes at evenly spaced times over the clip, the last one
+  // at `duration`, Model::m_PaletteBoneCount matrices each. Empty unless
+  // Model::BakeAnimationPoses ran.
+  std::vector<glm::mat4> bakedPalettes;
+  uint32_t bakedFrames = 0;
+};
+
+// How Model::UpdateAnimation treated an instance this frame.
+enum class AnimationUpdate : uint8_t
+{
+  FULL = 0,      // evaluated with every bone
+  REDUCED = 1,   // evaluated with the reduced bone set
+  THROTTLED = 2, // skipped, small on screen; its time catches up later
+  FROZEN = 3     // skipped, outside the frustum
+};
+
+// Playback state of one instance of an animated model. The clips and the
+// skeleton it samples live on the Model and are shared by all instances.
+struct Animator
+{
+  int m_CurrentAnimationIndex = -1;
+  int m_NextAnimationIndex = -1;
+  float m_CurrentTime = 0.0f;
+  float m_NextTime = 0.0f;
+  float m_Duration = 1.0f;
+  float m_TicksPerSecond = 25.0f;
+  float m_DurationNext = 1.0f;
+  float m_TicksPerSecondNext = 25.0f;
+  float m_BlendTime = 0.0f;
+  float m_BlendDuration = 0.5f; // Blend duration in seconds
+  bool m_IsBlending = false;
+  bool m_BlendFromSnapshot = false;
+  // Local pose per skeleton node of an interrupted blend; empty otherwise.
+  std::vector<TransformTRS> m_BlendSourcePose;
+
+  // Sampler cursors of the current and the next clip, and the sampled local
+  // transforms (one per track): composed while playing one clip, as
+  // TransformTRS while blending so both clips mix per channel.
+  std::vector<int32_t> m_TrackCursors;
+  std::vector<int32_t> m_TrackCursorsNext;
+  std::vector<AffineTransform> m_LocalPose;
+  std::vector<TransformTRS> m_BlendPose;
+  std::vector<TransformTRS> m_BlendPoseNext;
+  std::vector<glm::mat4> m_GlobalPose; // scratch, one per skeleton node
+  std::vector<glm::mat4> m_FinalBoneMatrices;
+  // Baked frame shared with every instance at the same clip and phase,
+  // used in place of m_FinalBoneMatrices; null when sampled.
+  const glm::mat4* m_BakedPalette = nullptr;
+  // Palette at m_PaletteSlot * MAX_BONES in the bone matrix SSBO, assigned
+  // by ModelManager.
+  uint32_t m_PaletteSlot = 0;
+
+  // Animation LOD inputs from the last culling pass, and the frames and
+  // time skipped since the last evaluation.
+  bool m_Visible = true;
+  float m_ProjectedRadius = 1.0f;
+  uint32_t m_SkippedFrames = 0;
+  float m_SkippedTime = 0.0f;
 };
 
 struct Vertex
@@ -104,10 +239,42 @@ struct Vertex
   int EntityID;
 };
 
+// GPU-side layout of the shared VBO when PACKED_VERTICES is set. Vertex stays
+// the CPU format; the packing happens once in ModelManager::UploadToGPU.
+struct PackedVertex
+{
+  glm::vec3 Position;
+  uint32_t Normal;    // snorm 10:10:10:2
+  uint32_t Tangent;   // snorm 10:10:10:2, w = bitangent sign
+  uint32_t TexCoords; // half2
+  int8_t BoneIDs[MAX_BONE_INFLUENCE];
+  uint8_t Weights[MAX_BONE_INFLUENCE]; // unorm8
+};
+static_assert(sizeof(PackedVertex) == 32);
+
+// Cluster of LOD 0 triangles with its culling bounds (model space). Meshlets
+// are stored back to back in m_Indices, so a run of surviving meshlets is
+// still a single index range.
+struct Meshlet
+{
+  uint32_t FirstIndex; // relative to the start of the mesh's LOD 0 indices
+  uint32_t IndexCount;
+  glm::vec3 Center;
+  float Radius;
+  glm::vec3 ConeApex;
+  float ConeCutoff;   // cos of the cone half-angle; >= 1 means no backface cull
+  glm::vec3 ConeAxis;
+};
+
 struct Mesh
 {
   std::vector<Vertex> m_Vertices;
   std::vector<GLuint> m_Indices;
+  // LOD 1..MESH_LOD_COUNT-1, each coarser than the last. They index the same
+  // vertices as m_Indices and follow it in the shared index buffer.
+  std::array<std::vector<GLuint>, MESH_LOD_COUNT - 1> m_LodIndices;
+  // Empty for small meshes, which are always drawn whole.
+  std::vector<Meshlet> m_Meshlets;
   std::vector<std::shared_ptr<Texture>> m_Textures;
   std::vector<GLuint64> m_TexturesBindlessHandles;
 
@@ -131,13 +298,41 @@ struct Model
   static std::shared_ptr<Model> CreateSTATIC(const char* path, float optimizerStrength, bool isKinematic, MeshType type);
   static std::shared_ptr<Model> CreateANIMATED(const char* path, float optimizerStrength, bool isKinematic, MeshType type);
 
+  // Without an instance these drive every instance of the model, and
+  // IsInAnimation asks about instance 0. Instances added later start on the
+  // clip last given to SetAnimationbyIndex.
   void UpdateAnimation(const DeltaTime& dt);
   void SetAnimationbyIndex(int animationIndex);
   void SetAnimationByName(const std::string& animationName);
   void StartBlendToAnimation(int32_t nextAnimationIndex, float blendDuration);
   bool IsInAnimation(int index) const;
+  // Evaluates the instance's pose, or skips it as its animation LOD allows.
+  AnimationUpdate UpdateAnimation(uint32_t instance, const DeltaTime& dt);
+  // Animation LOD inputs, set by the renderer's culling pass.
+  void SetAnimationView(uint32_t instance, bool visible, float projectedRadius);
+  void SetAnimationbyIndex(uint32_t instance, int animationIndex);
+  void StartBlendToAnimation(uint32_t instance, int32_t nextAnimationIndex, float blendDuration);
+  bool IsInAnimation(uint32_t instance, int index) const;
+  // One animator per instance, called by ModelManager as instances change.
+  void ResizeAnimators(size_t count);
+  // Samples every clip at `frameRate` frames per second into bakedPalettes.
+  // Instances then read baked frames instead of sampling their clip, except
+  // while blending between clips.
+  void BakeAnimationPoses(float frameRate);
   void CreatePhysXStaticMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices);
+  // One cooked triangle mesh (and shape) for all meshes of the model.
+  void CreatePhysXMergedStaticMesh();
   void CreatePhysXDynamicMesh(std::vector<Vertex>& m_Vertices);
+  // Convex proxy hulls built from the render meshes, all on one dynamic actor.
+  void CreatePhysXConvexProxy();
+  // Cooks the collision of every mesh (or the merged mesh, or the convex
+  // proxy hulls) across job workers. Only touches m_Meshes and the cooked
+  // streams, so it can run on a worker right after import; no PhysX
+  // objects are created.
+  void CookCollision();
+  // Adds mesh `meshIndex`'s triangle shape from its pre-cooked stream,
+  // cooking it now if CookCollision has not run.
+  void CreatePhysXMeshCollision(size_t meshIndex);
   void CreateCharacterController(const PxVec3& position, float radius, float height, bool slopeLimit);
 
   inline std::vector<Mesh>& GetMeshes() { return m_Meshes; }
@@ -147,7 +342,14 @@ struct Model
   inline float GetDuration() { return m_Duration; }
   inline const AssimpNodeData& GetRootNode() { return m_RootNode; }
   inline bool IsAnimated() { return m_isAnimated; }
-  inline const std::vector<glm::mat4>& GetFinalBoneMatrices() { return m_FinalBoneMatrices; }
+  // m_PaletteBoneCount matrices.
+  inline const glm::mat4* GetBonePalette(uint32_t instance) const
+  {
+    const Animator& animator = m_Animators[instance];
+    return animator.m_BakedPalette ? animator.m_BakedPalette : animator.m_FinalBoneMatrices.data();
+  }
+  inline uint32_t GetPaletteBoneCount() const { return m_PaletteBoneCount; }
+  inline uint32_t GetPaletteSlot(size_t instance) const { return instance < m_Animators.size() ? m_Animators[instance].m_PaletteSlot : 0; }
   inline const MeshType& GetPhysXMeshType() { return m_meshType; }
   inline const PxRigidStatic* GetStaticActor() { return m_StaticMeshActor; }
   inline const PxRigidDynamic* GetDynamicActor() { return m_DynamicMeshActor; }
@@ -157,6 +359,12 @@ struct Model
   inline float GetBoundsRadius() const { return m_BoundsRadius * m_CullingBoundsScale; }
   inline float GetCullingBoundsScale() const { return m_CullingBoundsScale; }
   inline void SetCullingBoundsScale(float scale) { m_CullingBoundsScale = glm::clamp(scale, 0.01f, 100.0f); }
+  inline bool GetMergeCollision() const { return m_MergeCollision; }
+  inline void SetMergeCollision(bool merge) { m_MergeCollision = merge; }
+  // A rendered model that also carries convex proxy hulls on its own
+  // dynamic actor, which then drives its transform.
+  inline bool GetConvexProxy() const { return m_ConvexProxy; }
+  inline void SetConvexProxy(bool proxy) { m_ConvexProxy = proxy; }
 
   Transform m_ControllerTransform;
   PxVec3 m_ControllerPosition;
@@ -176,34 +384,30 @@ struct Model
   glm::vec3 m_BoundsCenter = glm::vec3(0.0f);
   float m_BoundsRadius = 0.0f;
   float m_CullingBoundsScale = 1.0f;
+  bool m_MergeCollision = false;
+  bool m_ConvexProxy = false;
+  // Output of CookCollision: one stream per mesh, a single stream when the
+  // collision is merged, or one per proxy hull for convex and convex proxy
+  // models. Released once the shapes exist.
+  std::vector<std::vector<uint8_t>> m_CookedCollision;
 
   std::unordered_map<std::string, std::shared_ptr<Texture>> m_TexturesLoaded; 
   std::vector<Mesh> m_Meshes;
-  std::vector<Bone> m_Bones;
+  // Clips are immutable once loaded and shared by every animator, which
+  // refers to them by index.
   std::vector<AnimationData> m_ProcessedAnimations;
   std::map<std::string, BoneInfo> m_BoneInfoMap;
-  std::vector<glm::mat4> m_FinalBoneMatrices;
 
-  std::vector<Bone> m_BonesNext;
-  float m_TicksPerSecondNext = 0.0f;
-  float m_DurationNext = 0.0f;
-
-  AssimpNodeData m_RootNode;
+  AssimpNodeData m_RootNode; // scene node hierarchy, one for all clips
+  std::vector<SkeletonNode> m_Skeleton;
+  std::vector<Animator> m_Animators; // one per instance
+  uint32_t m_PaletteBoneCount = 0;   // highest palette index in m_Skeleton + 1
   glm::mat4 m_GlobalInverseTransform = glm::mat4(1.0f);
   int m_BoneCounter = 0;
   std::string m_Directory;
-  float m_BlendTime = 0.0f;
-  float m_BlendDuration = 0.5f; // Blend duration in seconds
-  bool m_IsBlending = false;
-  bool m_BlendFromSnapshot = false;
-  std::unordered_map<std::string, glm::mat4> m_BlendSourcePose;
-  int m_NextAnimationIndex = -1;
-  int m_CurrentAnimationIndex = -1;
+  int m_CurrentAnimationIndex = -1; // clip set for the whole model
   float m_Duration = 1.0f;
   float m_TicksPerSecond = 25.0f;
-  float m_CurrentTime = 0.0f;
-  float m_NextTime = 0.0f;
-  float m_DeltaTime = 0.0f;
 
   bool m_isKinematic;
   float m_OptimizerStrength;
@@ -216,26 +420,41 @@ struct Model
 
 private:
 
-  void processNode(aiNode* node, const aiScene* scene);
-  Mesh processMesh(aiMesh* mesh, const aiScene* scene);
+  void processNode(aiNode* node, const aiScene* scene, std::vector<aiMesh*>& outMeshes);
+  void processMeshes(const std::vector<aiMesh*>& meshes, const aiScene* scene);
+  void processMesh(const aiMesh* mesh, Mesh& result) const;
+  void loadMeshTextures(const aiMesh* mesh, const aiScene* scene, Mesh& result);
   bool loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, std::vector<std::shared_ptr<Texture>>& textures);
-  void OptimizeMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices);
-  void ExtractBoneWeightForVertices(std::vector<Vertex>& vertices, aiMesh* mesh);
-  void SetDefaultBoneData(Vertex& vertex);
-  void SetBoneData(Vertex& vertex, int boneID, float weight);
-  void NormalizeBoneWeights(Vertex& vertex);
-  void CalculateBoneTransform(const AssimpNodeData* node, const glm::mat4& parentTransform);
-  void CalculateBlendedBoneTransform(const AssimpNodeData* node, float timeCurrent, float timeNext,
-    const glm::mat4& parentTransform, float blendFactor);
-  void CaptureBlendedLocalPose(const AssimpNodeData* node, float blendFactor,
-    std::unordered_map<std::string, glm::mat4>& outPose) const;
-  glm::mat4 SampleLocalTransform(const AssimpNodeData& node, const std::vector<Bone>& bones,
-    float animationTime) const;
-
-  const Bone* FindBoneInList(const std::string& name, const std::vector<Bone>& bones) const;
-  void ResizeFinalBoneMatrices();
+  void OptimizeMesh(std::vector<Vertex>& m_Vertices, std::vector<GLuint>& m_Indices) const;
+  void GenerateLods(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices, std::array<std::vector<GLuint>, MESH_LOD_COUNT - 1>& lods) const;
+  void BuildMeshlets(const std::vector<Vertex>& vertices, std::vector<GLuint>& indices, std::vector<Meshlet>& meshlets) const;
+  void RegisterBones(const aiMesh* mesh);
+  void ExtractBoneWeightForVertices(std::vector<Vertex>& vertices, const aiMesh* mesh) const;
+  void SetDefaultBoneData(Vertex& vertex) const;
+  void SetBoneData(Vertex& vertex, int boneID, float weight) const;
+  static std::vector<uint8_t> CookStaticMesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices);
+  static std::vector<uint8_t> CookDynamicMesh(const std::vector<Vertex>& vertices);
+  std::vector<uint8_t> CookMergedStaticMesh() const;
+  std::vector<std::vector<PxVec3>> BuildConvexProxy() const;
+  std::vector<std::vector<uint8_t>> CookConvexProxy() const;
+  void AddPhysXStaticShape(const std::vector<uint8_t>& cooked);
+  void AddPhysXDynamicShape(const std::vector<uint8_t>& cooked);
+  void NormalizeBoneWeights(Vertex& vertex) const;
+  void BuildSkeleton();
+  void UpdateAnimator(Animator& animator, float delta, bool reduced = false) const;
+  void PlayAnimation(Animator& animator, int animationIndex) const;
+  void BlendToAnimation(Animator& animator, int32_t nextAnimationIndex, float blendDuration) const;
+  void CalculateBoneTransform(Animator& animator, bool reduced = false) const;
+  void SampleBakedPose(Animator& animator, const AnimationData& animation) const;
+  void CalculateBlendedBoneTransform(Animator& animator, float blendFactor) const;
+  void CaptureBlendedLocalPose(Animator& animator, float blendFactor, std::vector<TransformTRS>& outPose) const;
+  void SampleBlendSources(Animator& animator) const;
+  TransformTRS GetLocalTransform(size_t node, int animationIndex, const std::vector<TransformTRS>& localPose) const;
+  TransformTRS GetBlendedLocalTransform(const Animator& animator, size_t node, float blendFactor) const;
+  void StoreGlobalTransform(Animator& animator, size_t node, const glm::mat4& localTransform) const;
+
   void ReadHierarchyData(AssimpNodeData& dest, const aiNode* src);
-  void ReadMissingBones(const aiAnimation* animation);
+  void ReadMissingBones(const aiAnimation* animation, std::vector<Bone>& bones);
 };
 
 enum class Movement : int32_t
@@ -246,18 +465,64 @@ enum class Movement : int32_t
   RIGHT = 3
 };
 
+// Resumable form of ModelManager::BakeModel. Each Step() does one bounded
+// unit of work -- one texture upload, or one mesh's vertex/index append and
+// PhysX actor -- so scene loading can spread a bake over several frames.
+struct ModelBake
+{
+  ModelBake(std::string path, std::shared_ptr<Model> model);
+  ~ModelBake();
+
+  // Returns true once the model is registered with ModelManager.
+  bool Step();
+  float GetProgress() const;
+  inline bool IsDone() const { return m_Stage == Stage::DONE; }
+
+private:
+  enum class Stage { TEXTURES, GEOMETRY, DONE };
+
+  void UploadRawTexture(Texture& texture);
+  void AppendMesh(size_t meshIndex);
+
+  std::string m_Path;
+  std::string m_Name;
+  std::shared_ptr<Model> m_Model;
+  Stage m_Stage = Stage::TEXTURES;
+  size_t m_MeshIndex = 0;
+  size_t m_TextureIndex = 0;
+  float m_BakeMillis = 0.0f;
+};
+
+// Animated instances per AnimationUpdate in the last UpdateAnimations.
+struct AnimationStats
+{
+  uint32_t full = 0;
+  uint32_t reduced = 0;
+  uint32_t throttled = 0;
+  uint32_t frozen = 0;
+};
+
 struct ModelManager
 {
   static void Init();
   static void Shutdown();
   static void BakeModel(const std::string& path, const std::shared_ptr<Model>& model);
   static void UploadToGPU();
+  // The two halves of UploadToGPU, for callers that spread them over frames.
+  static void UploadGeometry();
+  static void CreateStorageBuffers();
   static std::shared_ptr<Model> GetModel(const std::string& name);
   static const std::vector<std::string>& GetModelNames();
   static std::vector<glm::mat4> GetTransforms();
   static GLsizei GetModelsQuantity();
   static GLuint GetModelsVAO();
-  static void UploadVisibleInstanceTransforms(const std::vector<glm::mat4>& transforms);
+  // GL_UNSIGNED_SHORT when every mesh fits 16-bit indices, else GL_UNSIGNED_INT.
+  static GLenum GetModelsIndexType();
+  static GLsizeiptr GetModelsIndexSize();
+  // `palettes` holds the bone palette slot of each visible instance,
+  // parallel to `transforms`.
+  static void UploadVisibleInstanceTransforms(const std::vector<glm::mat4>& transforms, const std::vector<uint32_t>& palettes);
+  // Bind the instance transforms with their palette slots.
   static void BindAllInstanceTransforms();
   static void BindVisibleInstanceTransforms();
   static void SetRender(const std::string& name ,bool render);
@@ -271,6 +536,11 @@ struct ModelManager
   static void Reset();
   static void UpdateControllers(const DeltaTime& dt);
   static void UpdateTransforms(const DeltaTime& dt);
+  // Evaluates the poses of every instance of the rendered animated models
+  // across job workers, as their animation LOD allows, then uploads the
+  // evaluated bone palettes in one write.
+  static void UpdateAnimations(const DeltaTime& dt);
+  static const AnimationStats& GetAnimationStats();
   static void MoveController(const std::string& name, const Movement& movement, float speed, const DeltaTime& dt);
 };
 
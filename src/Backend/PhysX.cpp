@@ -1,9 +1,14 @@
 #include "PhysX.h"
 #include "Logger.h"
+#include "JobSystem.h"
+#include "PhysXCache.h"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
 #include <algorithm>
 #include <cmath>
+#include <format>
+#include <string>
+#include <vector>
 
 struct UserErrorCallback : public PxErrorCallback
 {
@@ -16,12 +21,27 @@ struct UserErrorCallback : public PxErrorCallback
 
 #define PVD_HOST "127.0.0.1"
 
+// Feeds PhysX simulation tasks to the engine job system instead of a private
+// PxDefaultCpuDispatcher pool, so physics and loading share the same workers.
+struct JobSystemCpuDispatcher : public PxCpuDispatcher
+{
+  void submitTask(PxBaseTask& task) override
+  {
+    JobSystem::Submit([&task]() { task.run(); task.release(); }, JobPriority::HIGH);
+  }
+
+  uint32_t getWorkerCount() const override
+  {
+    return JobSystem::GetWorkerCount();
+  }
+} gJobDispatcher;
+
 struct PhysXData
 {
   PxDefaultAllocator		gAllocator;
   PxFoundation*			gFoundation = nullptr;
   PxPhysics*				gPhysics	= nullptr;
-  PxDefaultCpuDispatcher*	gDispatcher = nullptr;
+  PxCpuDispatcher*	gDispatcher = nullptr;
   PxScene*				gScene		= nullptr;
   PxMaterial*				gMaterial	= nullptr;
   PxPvd*					gPvd        = nullptr;
@@ -52,7 +72,7 @@ void PhysX::Init()
 
   PxSceneDesc sceneDesc(s_PhysXData.gPhysics->getTolerancesScale());
   sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
-  s_PhysXData.gDispatcher = PxDefaultCpuDispatcherCreate(2);
+  s_PhysXData.gDispatcher = &gJobDispatcher;
   sceneDesc.cpuDispatcher	= s_PhysXData.gDispatcher;
   sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
   s_PhysXData.gScene = s_PhysXData.gPhysics->createScene(sceneDesc);
@@ -88,11 +108,7 @@ void PhysX::Shutdown()
     s_PhysXData.gScene->release();
     s_PhysXData.gScene = nullptr;
   }
-  if (s_PhysXData.gDispatcher)
-  {
-    s_PhysXData.gDispatcher->release();
-    s_PhysXData.gDispatcher = nullptr;
-  }
+  s_PhysXData.gDispatcher = nullptr;
   if (s_PhysXData.gPhysics)
   {
     s_PhysXData.gPhysics->release();
@@ -142,6 +158,37 @@ void PhysX::Simulate(DeltaTime& dt)
     accumulator = std::fmod(accumulator, fixedTimeStep);
 }
 
+// Everything in PxCookingParams that changes the cooked stream; part of the
+// PhysXCache key.
+static std::string DescribeCookingParams(const PxCookingParams& params)
+{
+  return std::format("{}|{}|{}|{}|{}|{}|{}|{}",
+    params.scale.length, params.scale.speed,
+    static_cast<uint32_t>(params.meshPreprocessParams),
+    params.suppressTriangleMeshRemapTable,
+    static_cast<int>(params.midphaseDesc.getType()),
+    static_cast<int>(params.midphaseDesc.mBVH33Desc.meshCookingHint),
+    params.midphaseDesc.mBVH33Desc.meshSizePerformanceTradeOff,
+    params.meshWeldTolerance);
+}
+
+// Cooks through the PhysXCache: a hit skips cooking, a miss cooks into
+// memory and stores the stream.
+template<typename Desc, typename CookFn>
+static bool CookCached(const PxCookingParams& params, const Desc& desc, uint64_t key, CookFn&& cook, std::vector<uint8_t>& cooked)
+{
+  if (PhysXCache::Load(key, cooked))
+    return true;
+
+  PxDefaultMemoryOutputStream output;
+  if (!cook(params, desc, output))
+    return false;
+
+  cooked.assign(output.getData(), output.getData() + output.getSize());
+  PhysXCache::Save(key, cooked);
+  return true;
+}
+
 inline void SetupCommonCookingParams(PxCookingParams& params, bool skipMeshCleanup, bool skipEdgeData)
 {
   // we suppress the triangle mesh remap table computation to gain some speed, as we will not need it
@@ -168,7 +215,7 @@ inline void SetupCommonCookingParams(PxCookingParams& params, bool skipMeshClean
       params.meshPreprocessParams |= PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE;
 }
 
-PxTriangleMesh* PhysX::CreateTriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 numTriangles, const PxU32* indices)
+std::vector<uint8_t> PhysX::CookTriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 numTriangles, const PxU32* indices)
 {
   PxTriangleMeshDesc meshDesc;
   meshDesc.points.count = numVertices;
@@ -212,32 +259,71 @@ PxTriangleMesh* PhysX::CreateTriangleMesh(PxU32 numVertices, const PxVec3* verti
       PX_ASSERT(PxValidateTriangleMesh(params, meshDesc));
   }
 
-  PxTriangleMesh* triMesh = NULL;
-  //PxU32 meshSize = 0;
+  const uint64_t key = PhysXCache::MakeKey("triangle", DescribeCookingParams(params),
+    vertices, numVertices * sizeof(PxVec3), indices, numTriangles * 3 * sizeof(PxU32));
 
-  triMesh = PxCreateTriangleMesh(params, meshDesc, s_PhysXData.gPhysics->getPhysicsInsertionCallback());
-  return triMesh;
-  //triMesh->release();
+  std::vector<uint8_t> cooked;
+  const auto cook = [](const PxCookingParams& p, const PxTriangleMeshDesc& d, PxOutputStream& out) { return PxCookTriangleMesh(p, d, out); };
+  if (!CookCached(params, meshDesc, key, cook, cooked))
+    cooked.clear();
+  return cooked;
 }
 
-PxConvexMesh* PhysX::CreateConvexMesh(PxU32 numVertices, const PxVec3* vertices)
+PxTriangleMesh* PhysX::CreateTriangleMesh(const std::vector<uint8_t>& cooked)
+{
+  if (cooked.empty())
+    return nullptr;
+
+  PxDefaultMemoryInputData input(const_cast<PxU8*>(cooked.data()), static_cast<PxU32>(cooked.size()));
+  return s_PhysXData.gPhysics->createTriangleMesh(input);
+}
+
+PxTriangleMesh* PhysX::CreateTriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 numTriangles, const PxU32* indices)
+{
+  return CreateTriangleMesh(CookTriangleMesh(numVertices, vertices, numTriangles, indices));
+}
+
+std::vector<uint8_t> PhysX::CookConvexMesh(PxU32 numVertices, const PxVec3* vertices, PxU16 vertexLimit, PxU16 quantizedCount)
 {
   PxConvexMeshDesc convexDesc;
   convexDesc.points.count     = numVertices;
   convexDesc.points.stride    = sizeof(PxVec3);
   convexDesc.points.data      = vertices;
-  convexDesc.flags            = PxConvexFlag::eCOMPUTE_CONVEX;
+  convexDesc.flags            = PxConvexFlag::eCOMPUTE_CONVEX | PxConvexFlag::eSHIFT_VERTICES;
+  convexDesc.vertexLimit      = std::clamp<PxU16>(vertexLimit, 4, 255);
+  if (quantizedCount > 0 && numVertices > quantizedCount)
+  {
+    convexDesc.flags |= PxConvexFlag::eQUANTIZE_INPUT;
+    convexDesc.quantizedCount = quantizedCount;
+  }
 
   PxTolerancesScale scale;
   PxCookingParams params(scale);
   SetupCommonCookingParams(params,false,false); // Optional: reuse your cooking param setup
 
-  PxConvexMesh* convexMesh = nullptr;
+  const uint64_t key = PhysXCache::MakeKey(std::format("convex|{}|{}|{}", static_cast<uint32_t>(convexDesc.flags),
+    convexDesc.vertexLimit, convexDesc.quantizedCount),
+    DescribeCookingParams(params), vertices, numVertices * sizeof(PxVec3));
 
-  // Create the mesh
-  convexMesh = PxCreateConvexMesh(params, convexDesc, s_PhysXData.gPhysics->getPhysicsInsertionCallback());
+  std::vector<uint8_t> cooked;
+  const auto cook = [](const PxCookingParams& p, const PxConvexMeshDesc& d, PxOutputStream& out) { return PxCookConvexMesh(p, d, out); };
+  if (!CookCached(params, convexDesc, key, cook, cooked))
+    cooked.clear();
+  return cooked;
+}
+
+PxConvexMesh* PhysX::CreateConvexMesh(const std::vector<uint8_t>& cooked)
+{
+  if (cooked.empty())
+    return nullptr;
 
-  return convexMesh;
+  PxDefaultMemoryInputData input(const_cast<PxU8*>(cooked.data()), static_cast<PxU32>(cooked.size()));
+  return s_PhysXData.gPhysics->createConvexMesh(input);
+}
+
+PxConvexMesh* PhysX::CreateConvexMesh(PxU32 numVertices, const PxVec3* vertices)
+{
+  return CreateConvexMesh(CookConvexMesh(numVertices, vertices));
 }
 
 PxController* PhysX::CreateCharacterController(const PxVec3& position, float radius, float height, bool slopeLimit)
@@ -5,6 +5,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "DeltaTime.hpp"
 
+#include <cstdint>
+#include <vector>
+
 using namespace physx;
 
 struct PhysicsRaycastHit
@@ -30,6 +33,15 @@ struct PhysX
   static void DisableRaycast(PxShape* shape);
   static void EnableRaycast(PxShape* shape);
 
+  // Cook* only touch the PhysXCache and the cooking library, so they are safe
+  // to run on worker threads. Create* from a cooked stream is the cheap
+  // main-thread half; the raw-data overloads do both.
+  static std::vector<uint8_t> CookTriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 numTriangles, const PxU32* indices);
+  // `vertexLimit` caps the hull (4..255); a non-zero `quantizedCount`
+  // first reduces the input points to that many with k-means.
+  static std::vector<uint8_t> CookConvexMesh(PxU32 numVertices, const PxVec3* vertices, PxU16 vertexLimit = 255, PxU16 quantizedCount = 0);
+  static PxTriangleMesh* CreateTriangleMesh(const std::vector<uint8_t>& cooked);
+  static PxConvexMesh* CreateConvexMesh(const std::vector<uint8_t>& cooked);
   static PxTriangleMesh* CreateTriangleMesh(PxU32 numVertices, const PxVec3* vertices, PxU32 numTriangles, const PxU32* indices);
   static PxConvexMesh* CreateConvexMesh(PxU32 numVertices, const PxVec3* vertices);
   static PxController* CreateCharacterController(const PxVec3& position, float radius, float height, bool slopeLimit);
@@ -0,0 +1,87 @@
+#include "PhysXCache.h"
+#include "BinaryStream.hpp"
+#include "MappedFile.h"
+#include "Logger.h"
+
+#include <foundation/PxPhysicsVersion.h>
+
+#include <filesystem>
+#include <format>
+#include <string_view>
+
+namespace
+{
+  constexpr uint32_t PHYSX_CACHE_MAGIC = 0x50424147; // "GABP"
+  constexpr uint32_t PHYSX_CACHE_VERSION = 1;
+  constexpr const char* PHYSX_CACHE_DIRECTORY = "../res/cache/physx";
+
+  std::filesystem::path GetCacheFile(uint64_t key)
+  {
+    return std::filesystem::path(PHYSX_CACHE_DIRECTORY) / std::format("{:016x}.gabpx", key);
+  }
+
+  size_t HashBytes(const void* data, size_t size)
+  {
+    return std::hash<std::string_view>{}(std::string_view(static_cast<const char*>(data), size));
+  }
+}
+
+uint64_t PhysXCache::MakeKey(const std::string& kind, const std::string& params,
+  const void* vertices, size_t vertexBytes, const void* indices, size_t indexBytes)
+{
+  const std::string key = std::format("{}|{}|{:x}|{}|{:016x}|{}|{:016x}", kind, params, PX_PHYSICS_VERSION,
+    vertexBytes, HashBytes(vertices, vertexBytes), indexBytes, indices ? HashBytes(indices, indexBytes) : 0);
+  return std::hash<std::string>{}(key);
+}
+
+bool PhysXCache::Load(uint64_t key, std::vector<uint8_t>& cooked)
+{
+  const auto cacheFile = GetCacheFile(key);
+  std::error_code ec;
+  if (!std::filesystem::exists(cacheFile, ec))
+    return false;
+
+  const MappedFile file(cacheFile);
+  if (!file.IsOpen())
+    return false;
+
+  BinaryReader reader(file.GetData(), file.GetSize());
+
+  uint32_t magic = 0, version = 0, physxVersion = 0, endMagic = 0;
+  uint64_t cachedKey = 0;
+  std::vector<uint8_t> data;
+  reader.Read(magic);
+  reader.Read(version);
+  reader.Read(physxVersion);
+  reader.Read(cachedKey);
+  reader.ReadVector(data);
+  reader.Read(endMagic);
+
+  if (!reader.IsValid() || magic != PHYSX_CACHE_MAGIC || version != PHYSX_CACHE_VERSION ||
+      physxVersion != PX_PHYSICS_VERSION || cachedKey != key || endMagic != PHYSX_CACHE_MAGIC ||
+      !reader.IsAtEnd() || data.empty())
+  {
+    GABGL_WARN("[PHYSXCACHE]: Corrupt entry {}", cacheFile.string());
+    return false;
+  }
+
+  cooked = std::move(data);
+  return true;
+}
+
+void PhysXCache::Save(uint64_t key, const std::vector<uint8_t>& cooked)
+{
+  if (cooked.empty())
+    return;
+
+  BinaryWriter writer;
+  writer.Write(PHYSX_CACHE_MAGIC);
+  writer.Write(PHYSX_CACHE_VERSION);
+  writer.Write(static_cast<uint32_t>(PX_PHYSICS_VERSION));
+  writer.Write(key);
+  writer.WriteVector(cooked);
+  writer.Write(PHYSX_CACHE_MAGIC);
+
+  if (!writer.SaveToFile(GetCacheFile(key)))
+    GABGL_WARN("[PHYSXCACHE]: Could not write {}", GetCacheFile(key).string());
+}
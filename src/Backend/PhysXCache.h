@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk store of cooked PhysX mesh streams (PxCookTriangleMesh /
+// PxCookConvexMesh output). Entries are keyed by a hash of the source
+// geometry and the cooking parameters, so warm loads only deserialize.
+struct PhysXCache
+{
+  // `kind` and `params` describe how the data is cooked; any change to
+  // either yields a different key.
+  static uint64_t MakeKey(const std::string& kind, const std::string& params,
+    const void* vertices, size_t vertexBytes, const void* indices = nullptr, size_t indexBytes = 0);
+
+  // Returns false on a miss or a stale/corrupt entry.
+  static bool Load(uint64_t key, std::vector<uint8_t>& cooked);
+  static void Save(uint64_t key, const std::vector<uint8_t>& cooked);
+};
@@ -16,7 +16,6 @@
 #include <cstdint>
 #include <limits>
 #include <cstring>
-#include <stb_image.h>
 #include <imgui.h>
 #include <imgui_internal.h>
 #include "backends/imgui_impl_glfw.h"
@@ -31,6 +30,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
 #include "Profiler.h"
+#include "JobSystem.h"
 #include "SceneManager.h"
 #include "Settings.h"
 #include "Timer.hpp"
@@ -113,6 +113,7 @@ struct RendererData
 	static constexpr uint32_t MaxVertices = MaxQuads * 4;
 	static constexpr uint32_t MaxIndices = MaxQuads * 6;
 	static constexpr uint32_t MaxTextureSlots = 32; // TODO: RenderCaps
+	static constexpr size_t StagingRingSize = 64 * 1024 * 1024;
 
 	std::shared_ptr<Texture> WhiteTexture;
 
@@ -173,7 +174,6 @@ struct RendererData
 		std::shared_ptr<Shader> BloomResultShader;
 		std::shared_ptr<Shader> OmniDirectShadowShader;
 		std::shared_ptr<Shader> DirectShadowShader;
-		std::shared_ptr<Shader> PhysicsDebugShader;
 	} s_Shaders;
 
   CameraData m_CameraBuffer;
@@ -191,15 +191,23 @@ struct RendererData
 
   std::vector<DrawElementsIndirectCommand> m_DrawCommands;
   std::vector<DrawElementsIndirectCommand> m_CulledDrawCommands;
+  // Culled draw -> m_DrawCommands index, so gl_DrawID keeps addressing the
+  // per-mesh SSBOs after commands are compacted or split into meshlet runs.
+  std::vector<GLuint> m_CulledDrawToCommand;
+  std::shared_ptr<StorageBuffer> m_DrawToCommandSSBO;
   std::vector<glm::mat4> m_VisibleInstanceTransforms;
+  std::vector<uint32_t> m_VisibleInstancePalettes; // bone palette slot per visible instance
   std::unordered_map<std::string, std::vector<size_t>> m_ModelDrawCommandIndices;
   uint32_t m_DrawIndexOffset = 0;
   uint32_t m_DrawVertexOffset = 0;
   uint32_t m_cmdBufer = 0;
   uint32_t m_CulledCmdBuffer = 0;
   size_t m_cmdBufferSize = 0;
+  size_t m_CulledCmdBufferSize = 0;
   uint32_t m_VisibleInstanceCount = 0;
   uint32_t m_RenderableInstanceCount = 0;
+  uint32_t m_VisibleMeshletCount = 0;
+  uint32_t m_TestedMeshletCount = 0;
   GLuint m_FullscreenQuadVAO = 0;
   GLuint m_FullscreenQuadVBO = 0;
   GLuint m_FramebufferQuadVAO = 0;
@@ -269,6 +277,77 @@ static WorldBoundingSphere TransformBoundingSphere(const Model& model, const glm
   return {center, std::max(model.GetBoundsRadius(), 0.001f) * maxScale};
 }
 
+// The sphere's radius on screen, 1.0 = half the screen height.
+static float ProjectedRadius(const WorldBoundingSphere& sphere, const glm::vec3& cameraPosition, float projectionScale)
+{
+  const float distance = glm::distance(sphere.center, cameraPosition);
+  return distance <= sphere.radius ? std::numeric_limits<float>::max() : sphere.radius * projectionScale / distance;
+}
+
+// Picks a mesh LOD from the sphere's projected radius.
+static uint32_t SelectMeshLod(float projectedRadius)
+{
+  static constexpr std::array<float, MESH_LOD_COUNT - 1> LOD_SCREEN_RADII = { 0.25f, 0.1f, 0.04f };
+
+  uint32_t lod = 0;
+  while (lod < LOD_SCREEN_RADII.size() && projectedRadius < LOD_SCREEN_RADII[lod])
+    ++lod;
+  return lod;
+}
+
+// Appends one command per run of consecutive meshlets of `meshCommand` (a LOD 0
+// draw) that survive frustum and normal-cone culling for a single instance.
+static void AppendVisibleMeshlets(const std::vector<Meshlet>& meshlets, const DrawElementsIndirectCommand& meshCommand,
+  GLuint commandIndex, const glm::mat4& transform, GLuint instance, const Frustum& frustum, const glm::vec3& cameraPosition)
+{
+  const glm::mat3 linear(transform);
+  const glm::vec3 scale(glm::length(linear[0]), glm::length(linear[1]), glm::length(linear[2]));
+  const float maxScale = std::max({ scale.x, scale.y, scale.z });
+  const float minScale = std::min({ scale.x, scale.y, scale.z });
+  // Cones only survive rotation and uniform scale; mirroring flips the winding.
+  const bool coneCull = glm::determinant(linear) > 0.0f && minScale >= maxScale * 0.99f;
+
+  uint32_t runStart = 0;
+  uint32_t runCount = 0;
+  const auto flushRun = [&]()
+  {
+    if (runCount == 0) return;
+    s_Data.m_CulledDrawCommands.push_back({
+      .count = runCount,
+      .instanceCount = 1,
+      .firstIndex = meshCommand.firstIndex + runStart,
+      .baseVertex = meshCommand.baseVertex,
+      .baseInstance = instance,
+    });
+    s_Data.m_CulledDrawToCommand.push_back(commandIndex);
+    runCount = 0;
+  };
+
+  for (const Meshlet& meshlet : meshlets)
+  {
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(meshlet.Center, 1.0f));
+    bool visible = frustum.IntersectsSphere(center, meshlet.Radius * maxScale);
+    if (visible && coneCull && meshlet.ConeCutoff < 1.0f)
+    {
+      const glm::vec3 apex = glm::vec3(transform * glm::vec4(meshlet.ConeApex, 1.0f));
+      const glm::vec3 axis = glm::normalize(linear * meshlet.ConeAxis);
+      visible = glm::dot(glm::normalize(apex - cameraPosition), axis) < meshlet.ConeCutoff;
+    }
+
+    if (!visible)
+    {
+      flushRun();
+      continue;
+    }
+
+    if (runCount == 0) runStart = meshlet.FirstIndex;
+    runCount += meshlet.IndexCount;
+    ++s_Data.m_VisibleMeshletCount;
+  }
+  flushRun();
+  s_Data.m_TestedMeshletCount += static_cast<uint32_t>(meshlets.size());
+}
+
 static void DrawWireSphere(const glm::vec3& center, float radius, const glm::vec4& color, int segments = 24)
 {
   if (radius <= 0.0f || segments < 3) return;
@@ -288,6 +367,40 @@ static void DrawWireSphere(const glm::vec3& center, float radius, const glm::vec
   }
 }
 
+// Polygon edges of every convex shape on `actor`, i.e. the cooked hulls it
+// collides with rather than the render mesh.
+static void DrawWireConvexShapes(const PxRigidActor& actor, const glm::vec4& color)
+{
+  for (PxU32 shapeIndex = 0; shapeIndex < actor.getNbShapes(); ++shapeIndex)
+  {
+    PxShape* shape = nullptr;
+    actor.getShapes(&shape, 1, shapeIndex);
+    if (!shape || shape->getGeometry().getType() != PxGeometryType::eCONVEXMESH)
+      continue;
+
+    const auto& geometry = static_cast<const PxConvexMeshGeometry&>(shape->getGeometry());
+    const PxConvexMesh* mesh = geometry.convexMesh;
+    const PxMat44 pose(PxShapeExt::getGlobalPose(*shape, actor));
+    const PxVec3* vertices = mesh->getVertices();
+    const PxU8* indices = mesh->getIndexBuffer();
+    const auto toWorld = [&](PxU8 index) {
+      const PxVec3 point = pose.transform(geometry.scale.transform(vertices[index]));
+      return glm::vec3(point.x, point.y, point.z);
+    };
+
+    for (PxU32 polygonIndex = 0; polygonIndex < mesh->getNbPolygons(); ++polygonIndex)
+    {
+      PxHullPolygon polygon;
+      if (!mesh->getPolygonData(polygonIndex, polygon) || polygon.mNbVerts < 2)
+        continue;
+
+      const PxU8* polygonIndices = indices + polygon.mIndexBase;
+      for (PxU16 k = 0; k < polygon.mNbVerts; ++k)
+        Renderer::DrawLine(toWorld(polygonIndices[k]), toWorld(polygonIndices[(k + 1) % polygon.mNbVerts]), color);
+    }
+  }
+}
+
 static void DrawWireCapsule(const glm::vec3& center, float radius, float height,
   const glm::vec3& upDirection, const glm::vec4& color, int segments = 24)
 {
@@ -434,7 +547,6 @@ void Renderer::LoadShaders()
 	Shader::Create(s_Data.s_Shaders.BloomResultShader, "../res/shaders/bloom_final.glsl");
 	Shader::Create(s_Data.s_Shaders.OmniDirectShadowShader, "../res/shaders/omni_shadowFB.glsl");
 	Shader::Create(s_Data.s_Shaders.DirectShadowShader, "../res/shaders/direct_shadowFB.glsl");
-	Shader::Create(s_Data.s_Shaders.PhysicsDebugShader, "../res/shaders/physics_debug.glsl");
 }
 
 void Renderer::Init()
@@ -453,6 +565,8 @@ void Renderer::Init()
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_LINE_SMOOTH);
 
+	StagingRing::Init(s_Data.StagingRingSize);
+
 	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
 	s_Data.QuadVertexArray = VertexArray::Create();
@@ -618,6 +732,8 @@ void Renderer::Shutdown()
 	s_Data.TextureSlots.fill(nullptr);
 	s_Data.WhiteTexture.reset();
 	s_Data.s_Shaders = {};
+
+	StagingRing::Shutdown();
 }
 
 void Renderer::DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic, bool advanceSimulation)
@@ -666,7 +782,7 @@ void Renderer::DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic
     glPolygonOffset(2.0f, 4.0f);
     glBindVertexArray(ModelManager::GetModelsVAO());
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER,s_Data.m_cmdBufer);
-    glMultiDrawElementsIndirect(GL_TRIANGLES,GL_UNSIGNED_INT,NULL,s_Data.m_DrawCommands.size(),0);
+    glMultiDrawElementsIndirect(GL_TRIANGLES,ModelManager::GetModelsIndexType(),NULL,s_Data.m_DrawCommands.size(),0);
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER,0);
     glBindVertexArray(0);
     glDisable(GL_POLYGON_OFFSET_FILL);
@@ -733,7 +849,7 @@ void Renderer::DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic
         glm::mat4 view = glm::lookAt(light,light + directions[face].Target,directions[face].Up);
         s_Data.s_Shaders.OmniDirectShadowShader->SetMat4("u_LightViewProjection", s_Data.m_OmniDirectShadowBuffer->GetShadowProj() * view);
 
-        glMultiDrawElementsIndirect(GL_TRIANGLES,GL_UNSIGNED_INT,NULL,s_Data.m_DrawCommands.size(),0);
+        glMultiDrawElementsIndirect(GL_TRIANGLES,ModelManager::GetModelsIndexType(),NULL,s_Data.m_DrawCommands.size(),0);
       }
     }
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER,0);
@@ -761,8 +877,9 @@ void Renderer::DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic
     BeginScene();
     glBindVertexArray(ModelManager::GetModelsVAO());
     ModelManager::BindVisibleInstanceTransforms();
+    if (s_Data.m_DrawToCommandSSBO) s_Data.m_DrawToCommandSSBO->Bind();
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_Data.m_CulledCmdBuffer);
-    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, s_Data.m_CulledDrawCommands.size(), 0);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, ModelManager::GetModelsIndexType(), NULL, s_Data.m_CulledDrawCommands.size(), 0);
     glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
     glBindVertexArray(0);
     EndScene();
@@ -824,7 +941,6 @@ void Renderer::DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic
     s_Data.m_ResultBuffer->SetDrawBuffer(0);
 
     DrawSkybox("night");
-    DrawPhysicsDebug();
     DrawDebugVisualizations();
     ParticleRenderer::UpdateAndRender(dt);
     DrawDebug2D();
@@ -878,7 +994,7 @@ void Renderer::DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic
   }
 }
 
-void Renderer::DrawLoadingScreen()
+void Renderer::DrawLoadingScreen(float progress)
 {
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
   glViewport(0, 0, Window::GetWidth(), Window::GetHeight());
@@ -901,10 +1017,14 @@ void Renderer::DrawLoadingScreen()
   DrawText(FontManager::GetFont("dpcomic"), label,
     glm::vec2(width * 0.5f, height * 0.5f), 0.82f * uiScale,
     glm::vec4(0.72f, 0.86f, 1.0f, pulse));
-  DrawQuad(
-    glm::vec2(width * 0.5f + std::sin(time * 1.8f) * 55.0f * uiScale, height * 0.44f),
-    glm::vec2(68.0f, 3.0f) * uiScale, 0.0f,
-    glm::vec4(0.28f, 0.58f, 0.92f, 0.65f));
+  const glm::vec2 barSize = glm::vec2(320.0f, 3.0f) * uiScale;
+  const float fillWidth = barSize.x * std::clamp(progress, 0.0f, 1.0f);
+  DrawQuad(glm::vec2(width * 0.5f, height * 0.44f), barSize, 0.0f,
+    glm::vec4(0.28f, 0.58f, 0.92f, 0.18f));
+  if (fillWidth > 0.0f)
+    DrawQuad(glm::vec2(width * 0.5f - (barSize.x - fillWidth) * 0.5f, height * 0.44f),
+      glm::vec2(fillWidth, barSize.y), 0.0f,
+      glm::vec4(0.28f, 0.58f, 0.92f, 0.65f));
   EndScene();
 }
 
@@ -1019,53 +1139,6 @@ void Renderer::ApplyGraphicsSettings()
   s_Data.m_AppliedShadowQuality = qualityValue;
 }
 
-void Renderer::DrawPhysicsDebug()
-{
-  if (!s_Data.m_PhysicsDebug || !s_Data.s_Shaders.PhysicsDebugShader)
-    return;
-
-  glEnable(GL_DEPTH_TEST);
-  glDepthFunc(GL_LEQUAL);
-  glDepthMask(GL_FALSE);
-  glDisable(GL_CULL_FACE);
-  glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-  glLineWidth(2.0f);
-
-  s_Data.s_Shaders.PhysicsDebugShader->Bind();
-  s_Data.s_Shaders.PhysicsDebugShader->SetVec4("u_Color", glm::vec4(0.15f, 1.0f, 0.35f, 1.0f));
-  ModelManager::BindAllInstanceTransforms();
-  glBindVertexArray(ModelManager::GetModelsVAO());
-
-  for (const auto& [modelName, commandIndices] : s_Data.m_ModelDrawCommandIndices)
-  {
-    const auto model = ModelManager::GetModel(modelName);
-    if (!model || model->GetPhysXMeshType() != MeshType::CONVEXMESH) continue;
-
-    const auto instanceCount = static_cast<GLsizei>(model->m_InstanceTransforms.size());
-    for (const size_t commandIndex : commandIndices)
-    {
-      const auto& command = s_Data.m_DrawCommands[commandIndex];
-      glDrawElementsInstancedBaseVertexBaseInstance(
-        GL_TRIANGLES,
-        static_cast<GLsizei>(command.count),
-        GL_UNSIGNED_INT,
-        reinterpret_cast<const void*>(static_cast<uintptr_t>(command.firstIndex) * sizeof(GLuint)),
-        instanceCount,
-        command.baseVertex,
-        model->m_InstanceBase);
-    }
-  }
-
-  glBindVertexArray(0);
-  s_Data.s_Shaders.PhysicsDebugShader->UnBind();
-
-  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-  glEnable(GL_CULL_FACE);
-  glDepthMask(GL_TRUE);
-  glDepthFunc(GL_LESS);
-  glLineWidth(s_Data.LineWidth);
-}
-
 void Renderer::DrawDebugVisualizations()
 {
   if (!s_Data.m_PhysicsDebug && !s_Data.m_LightDebug && !s_Data.m_CullingDebug) return;
@@ -1082,9 +1155,13 @@ void Renderer::DrawDebugVisualizations()
   if (s_Data.m_PhysicsDebug)
   {
     constexpr glm::vec4 controllerColor(0.15f, 0.8f, 1.0f, 0.9f);
+    constexpr glm::vec4 hullColor(0.15f, 1.0f, 0.35f, 1.0f);
     for (const std::string& modelName : ModelManager::GetModelNames())
     {
       const auto model = ModelManager::GetModel(modelName);
+      if (const PxRigidDynamic* actor = model ? model->GetDynamicActor() : nullptr)
+        DrawWireConvexShapes(*actor, hullColor);
+
       PxController* controller = model ? model->GetController() : nullptr;
       if (!controller || controller->getType() != PxControllerShapeType::eCAPSULE)
         continue;
@@ -1754,7 +1831,7 @@ void Renderer::BakeSkyboxTextures(const std::string& name, const std::shared_ptr
   auto channels = cubemap->GetChannels();
   auto width = cubemap->GetWidth();
   auto height = cubemap->GetHeight();
-  auto& pixels = cubemap->GetPixels();
+  auto& faces = cubemap->GetFaces();
 
   GLuint rendererID = 0;
   glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &rendererID);
@@ -1776,11 +1853,10 @@ void Renderer::BakeSkyboxTextures(const std::string& name, const std::shared_ptr
           width, height, 1, // width, height, depth (1 face)
           dataFormat,
           GL_UNSIGNED_BYTE,
-          pixels[i]
+          faces[i].Pixels
       );
 
-      stbi_image_free(pixels[i]);
-      pixels[i] = nullptr;
+      faces[i].Reset();
   }
 
   glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -1953,21 +2029,26 @@ void Renderer::DrawText(const Font* font, const std::string& text, const glm::ve
   }
 }
 
-void Renderer::AddDrawCommand(const std::string& modelName, uint32_t verticesSize, uint32_t indicesSize)
+void Renderer::AddDrawCommand(const std::string& modelName, uint32_t verticesSize, const std::array<uint32_t, MESH_LOD_COUNT>& lodIndexCounts)
 {
-  DrawElementsIndirectCommand cmd =
+  auto& commandIndices = s_Data.m_ModelDrawCommandIndices[modelName];
+  for (size_t lod = 0; lod < lodIndexCounts.size(); ++lod)
   {
-    .count = (indicesSize),
-    .instanceCount = 1,
-    .firstIndex = (s_Data.m_DrawIndexOffset),
-    .baseVertex = static_cast<GLint>(s_Data.m_DrawVertexOffset),
-    .baseInstance = 0,
-  };
+    const uint32_t lodIndexCount = lodIndexCounts[lod];
+    DrawElementsIndirectCommand cmd =
+    {
+      .count = (lodIndexCount),
+      .instanceCount = lod == 0 ? 1u : 0u,
+      .firstIndex = (s_Data.m_DrawIndexOffset),
+      .baseVertex = static_cast<GLint>(s_Data.m_DrawVertexOffset),
+      .baseInstance = 0,
+    };
 
-  s_Data.m_ModelDrawCommandIndices[modelName].push_back(s_Data.m_DrawCommands.size()); // store index
-  s_Data.m_DrawCommands.push_back(cmd);
+    commandIndices.push_back(s_Data.m_DrawCommands.size()); // store index
+    s_Data.m_DrawCommands.push_back(cmd);
+    s_Data.m_DrawIndexOffset += lodIndexCount;
+  }
 
-  s_Data.m_DrawIndexOffset += indicesSize;
   s_Data.m_DrawVertexOffset += verticesSize;
 }
 
@@ -1983,12 +2064,21 @@ void Renderer::UpdateModelFrustumCulling()
     return;
 
   const Frustum frustum(Camera::GetViewProjection());
+  const glm::vec3& cameraPosition = Camera::GetPosition();
+  const float projectionScale = Camera::GetProjection()[1][1];
   auto& visibleTransforms = s_Data.m_VisibleInstanceTransforms;
+  auto& visiblePalettes = s_Data.m_VisibleInstancePalettes;
   visibleTransforms.clear();
-  s_Data.m_CulledDrawCommands = s_Data.m_DrawCommands;
+  visiblePalettes.clear();
+  s_Data.m_CulledDrawCommands.clear();
+  s_Data.m_CulledDrawToCommand.clear();
   s_Data.m_VisibleInstanceCount = 0;
   s_Data.m_RenderableInstanceCount = 0;
+  s_Data.m_VisibleMeshletCount = 0;
+  s_Data.m_TestedMeshletCount = 0;
 
+  std::array<std::vector<glm::mat4>, MESH_LOD_COUNT> lodTransforms;
+  std::array<std::vector<uint32_t>, MESH_LOD_COUNT> lodPalettes;
   for (const std::string& modelName : ModelManager::GetModelNames())
   {
     const auto model = ModelManager::GetModel(modelName);
@@ -1996,35 +2086,97 @@ void Renderer::UpdateModelFrustumCulling()
     if (!model || commandIndices == s_Data.m_ModelDrawCommandIndices.end())
       continue;
 
-    const auto visibleBase = static_cast<GLuint>(visibleTransforms.size());
-    GLuint visibleCount = 0;
+    for (auto& transforms : lodTransforms)
+      transforms.clear();
+    for (auto& palettes : lodPalettes)
+      palettes.clear();
+
+    // Shadow passes draw every instance from the unculled commands, so they
+    // get one LOD per model: the finest any instance needs.
+    uint32_t shadowLod = MESH_LOD_COUNT - 1;
     if (model->m_IsRendered)
     {
       s_Data.m_RenderableInstanceCount += static_cast<uint32_t>(model->m_InstanceTransforms.size());
-      for (const glm::mat4& transform : model->m_InstanceTransforms)
+      for (size_t instance = 0; instance < model->m_InstanceTransforms.size(); ++instance)
       {
+        const glm::mat4& transform = model->m_InstanceTransforms[instance];
         const WorldBoundingSphere sphere = TransformBoundingSphere(*model, transform);
-        if (!frustum.IntersectsSphere(sphere.center, sphere.radius))
+        const float projectedRadius = ProjectedRadius(sphere, cameraPosition, projectionScale);
+        const uint32_t lod = SelectMeshLod(projectedRadius);
+        shadowLod = std::min(shadowLod, lod);
+        const bool visible = frustum.IntersectsSphere(sphere.center, sphere.radius);
+        if (model->IsAnimated())
+          model->SetAnimationView(static_cast<uint32_t>(instance), visible, projectedRadius);
+        if (!visible)
           continue;
 
-        visibleTransforms.push_back(transform);
-        ++visibleCount;
+        lodTransforms[lod].push_back(transform);
+        lodPalettes[lod].push_back(model->GetPaletteSlot(instance));
       }
     }
 
-    s_Data.m_VisibleInstanceCount += visibleCount;
-    for (const size_t commandIndex : commandIndices->second)
+    std::array<GLuint, MESH_LOD_COUNT> lodBase{};
+    for (uint32_t lod = 0; lod < MESH_LOD_COUNT; ++lod)
+    {
+      lodBase[lod] = static_cast<GLuint>(visibleTransforms.size());
+      visibleTransforms.insert(visibleTransforms.end(), lodTransforms[lod].begin(), lodTransforms[lod].end());
+      visiblePalettes.insert(visiblePalettes.end(), lodPalettes[lod].begin(), lodPalettes[lod].end());
+      s_Data.m_VisibleInstanceCount += static_cast<uint32_t>(lodTransforms[lod].size());
+    }
+
+    const GLuint shadowInstanceCount = model->m_IsRendered ? static_cast<GLuint>(model->m_InstanceTransforms.size()) : 0;
+    const auto& meshes = model->GetMeshes();
+    for (size_t i = 0; i < commandIndices->second.size(); ++i)
     {
-      auto& command = s_Data.m_CulledDrawCommands[commandIndex];
-      command.instanceCount = visibleCount;
-      command.baseInstance = visibleBase;
+      const GLuint commandIndex = static_cast<GLuint>(commandIndices->second[i]);
+      const uint32_t lod = static_cast<uint32_t>(i % MESH_LOD_COUNT);
+      const size_t meshIndex = i / MESH_LOD_COUNT;
+
+      auto& shadowCommand = s_Data.m_DrawCommands[commandIndex];
+      shadowCommand.instanceCount = lod == shadowLod ? shadowInstanceCount : 0;
+      shadowCommand.baseInstance = model->m_InstanceBase;
+
+      const GLuint instanceCount = static_cast<GLuint>(lodTransforms[lod].size());
+      if (instanceCount == 0)
+        continue;
+
+      // Large static meshes at full detail are culled per meshlet and per
+      // instance; skinned ones move out of their bind-pose meshlet bounds.
+      if (lod == 0 && !model->IsAnimated() && meshIndex < meshes.size() && !meshes[meshIndex].m_Meshlets.empty())
+      {
+        for (GLuint instance = 0; instance < instanceCount; ++instance)
+          AppendVisibleMeshlets(meshes[meshIndex].m_Meshlets, shadowCommand, commandIndex,
+            lodTransforms[lod][instance], lodBase[lod] + instance, frustum, cameraPosition);
+        continue;
+      }
+
+      DrawElementsIndirectCommand command = shadowCommand;
+      command.instanceCount = instanceCount;
+      command.baseInstance = lodBase[lod];
+      s_Data.m_CulledDrawCommands.push_back(command);
+      s_Data.m_CulledDrawToCommand.push_back(commandIndex);
     }
   }
 
-  ModelManager::UploadVisibleInstanceTransforms(visibleTransforms);
-  glNamedBufferSubData(s_Data.m_CulledCmdBuffer, 0,
-    static_cast<GLsizeiptr>(s_Data.m_CulledDrawCommands.size() * sizeof(DrawElementsIndirectCommand)),
-    s_Data.m_CulledDrawCommands.data());
+  ModelManager::UploadVisibleInstanceTransforms(visibleTransforms, visiblePalettes);
+
+  // Meshlet runs can outnumber the unculled commands, so grow on demand.
+  const size_t culledSize = s_Data.m_CulledDrawCommands.size() * sizeof(DrawElementsIndirectCommand);
+  if (culledSize > s_Data.m_CulledCmdBufferSize)
+  {
+    s_Data.m_CulledCmdBufferSize = std::max(culledSize, s_Data.m_CulledCmdBufferSize * 2);
+    glDeleteBuffers(1, &s_Data.m_CulledCmdBuffer);
+    glCreateBuffers(1, &s_Data.m_CulledCmdBuffer);
+    glNamedBufferStorage(s_Data.m_CulledCmdBuffer, static_cast<GLsizeiptr>(s_Data.m_CulledCmdBufferSize), nullptr, GL_DYNAMIC_STORAGE_BIT);
+  }
+  if (culledSize > 0)
+  {
+    glNamedBufferSubData(s_Data.m_CulledCmdBuffer, 0, static_cast<GLsizeiptr>(culledSize), s_Data.m_CulledDrawCommands.data());
+    s_Data.m_DrawToCommandSSBO->SetData(s_Data.m_CulledDrawToCommand.size() * sizeof(GLuint), s_Data.m_CulledDrawToCommand.data());
+  }
+  glNamedBufferSubData(s_Data.m_cmdBufer, 0,
+    static_cast<GLsizeiptr>(s_Data.m_DrawCommands.size() * sizeof(DrawElementsIndirectCommand)),
+    s_Data.m_DrawCommands.data());
 }
 
 void Renderer::UpdateDrawCommandInstances(const std::shared_ptr<Model>& model)
@@ -2036,10 +2188,11 @@ void Renderer::UpdateDrawCommandInstances(const std::shared_ptr<Model>& model)
     ? static_cast<GLuint>(model->m_InstanceTransforms.size())
     : 0;
 
-  for (const size_t commandIndex : commandIndices->second)
+  // Full detail until the next culling pass picks LODs.
+  for (size_t i = 0; i < commandIndices->second.size(); ++i)
   {
-    auto& command = s_Data.m_DrawCommands[commandIndex];
-    command.instanceCount = instanceCount;
+    auto& command = s_Data.m_DrawCommands[commandIndices->second[i]];
+    command.instanceCount = i % MESH_LOD_COUNT == 0 ? instanceCount : 0;
     command.baseInstance = model->m_InstanceBase;
   }
 
@@ -2062,11 +2215,18 @@ void Renderer::InitDrawCommandBuffer()
   if (s_Data.m_CulledCmdBuffer != 0) glDeleteBuffers(1, &s_Data.m_CulledCmdBuffer);
 
   s_Data.m_cmdBufferSize = s_Data.m_DrawCommands.size() * sizeof(DrawElementsIndirectCommand);
+  s_Data.m_CulledCmdBufferSize = s_Data.m_cmdBufferSize;
   s_Data.m_CulledDrawCommands = s_Data.m_DrawCommands;
+  s_Data.m_CulledDrawToCommand.resize(s_Data.m_DrawCommands.size());
+  for (size_t i = 0; i < s_Data.m_CulledDrawToCommand.size(); ++i)
+    s_Data.m_CulledDrawToCommand[i] = static_cast<GLuint>(i);
+
   glCreateBuffers(1, &s_Data.m_cmdBufer);
   glNamedBufferStorage(s_Data.m_cmdBufer, s_Data.m_cmdBufferSize, s_Data.m_DrawCommands.data(), GL_DYNAMIC_STORAGE_BIT);
   glCreateBuffers(1, &s_Data.m_CulledCmdBuffer);
-  glNamedBufferStorage(s_Data.m_CulledCmdBuffer, s_Data.m_cmdBufferSize, s_Data.m_CulledDrawCommands.data(), GL_DYNAMIC_STORAGE_BIT);
+  glNamedBufferStorage(s_Data.m_CulledCmdBuffer, s_Data.m_CulledCmdBufferSize, s_Data.m_CulledDrawCommands.data(), GL_DYNAMIC_STORAGE_BIT);
+  s_Data.m_DrawToCommandSSBO = StorageBuffer::Create(s_Data.m_CulledDrawToCommand.size() * sizeof(GLuint), 14);
+  s_Data.m_DrawToCommandSSBO->SetData(s_Data.m_CulledDrawToCommand.size() * sizeof(GLuint), s_Data.m_CulledDrawToCommand.data());
 }
 
 void Renderer::ResetModelDrawCommands()
@@ -2077,9 +2237,13 @@ void Renderer::ResetModelDrawCommands()
   s_Data.m_cmdBufer = 0;
   s_Data.m_CulledCmdBuffer = 0;
   s_Data.m_cmdBufferSize = 0;
+  s_Data.m_CulledCmdBufferSize = 0;
   s_Data.m_DrawCommands.clear();
   s_Data.m_CulledDrawCommands.clear();
+  s_Data.m_CulledDrawToCommand.clear();
+  s_Data.m_DrawToCommandSSBO.reset();
   s_Data.m_VisibleInstanceTransforms.clear();
+  s_Data.m_VisibleInstancePalettes.clear();
   s_Data.m_ModelDrawCommandIndices.clear();
   s_Data.m_DrawIndexOffset = 0;
   s_Data.m_DrawVertexOffset = 0;
@@ -2401,6 +2565,15 @@ void Renderer::DrawEditorFrameBuffer(uint32_t framebufferTexture)
 	ImGui::Checkbox("2D Debug", &s_Data.m_Debug2D);
 	ImGui::TextDisabled("Frustum culling: %u / %u model instances visible",
 		s_Data.m_VisibleInstanceCount, s_Data.m_RenderableInstanceCount);
+	ImGui::TextDisabled("Meshlet culling: %u / %u meshlets visible",
+		s_Data.m_VisibleMeshletCount, s_Data.m_TestedMeshletCount);
+	const AnimationStats& animation = ModelManager::GetAnimationStats();
+	ImGui::TextDisabled("Animation LOD: %u full, %u reduced, %u throttled, %u frozen",
+		animation.full, animation.reduced, animation.throttled, animation.frozen);
+	const StagingRing::Stats staging = StagingRing::GetStats();
+	ImGui::TextDisabled("Uploads: %.2f MB in %u copies last frame (%u stalls), ring %.0f MB",
+		static_cast<double>(staging.BytesLastFrame) / (1024.0 * 1024.0), staging.UploadsLastFrame,
+		staging.StallsLastFrame, static_cast<double>(staging.Capacity) / (1024.0 * 1024.0));
 
 	if (SceneEntity* entity = SceneManager::FindEntity(s_Data.m_SelectedEntityID))
 	{
@@ -2498,6 +2671,21 @@ void Renderer::DrawEditorFrameBuffer(uint32_t framebufferTexture)
         result.GPUTime);
   }
 
+  if (ImGui::CollapsingHeader("Job System"))
+  {
+    const auto workerStats = JobSystem::GetWorkerStats();
+    for (size_t i = 0; i < workerStats.size(); ++i)
+    {
+      const auto& stats = workerStats[i];
+      ImGui::Text("%s %zu: %.1f%% busy | %llu jobs | %llu stolen",
+        i + 1 < workerStats.size() ? "Worker" : "Helpers", i,
+        stats.utilization * 100.0f,
+        static_cast<unsigned long long>(stats.jobsExecuted),
+        static_cast<unsigned long long>(stats.jobsStolen));
+    }
+    if (ImGui::Button("Reset Job Stats")) JobSystem::ResetStats();
+  }
+
 	ImGui::End();
 
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2{ 0, 0 });
@@ -13,7 +13,7 @@ struct Renderer
 	static void Shutdown();
 
 	static void DrawScene(DeltaTime& dt, const std::function<void()>& scene_logic, bool advanceSimulation = true);
-	static void DrawLoadingScreen();
+	static void DrawLoadingScreen(float progress);
 	static void DrawScreenOverlay(float opacity, const glm::vec3& color = glm::vec3(0.0f));
 	static void BeginScene();
 	static void EndScene();
@@ -51,7 +51,8 @@ struct Renderer
 	static void SetLineWidth(float width);
 	static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID = -1);
 
-	static void AddDrawCommand(const std::string& modelName, uint32_t verticesSize, uint32_t indicesSize);
+	// Emits one command per LOD; LOD index ranges follow each other in the index buffer.
+	static void AddDrawCommand(const std::string& modelName, uint32_t verticesSize, const std::array<uint32_t, MESH_LOD_COUNT>& lodIndexCounts);
 	static void RebuildDrawCommandsForModel(const std::shared_ptr<Model>& model, bool render);
 	static void UpdateDrawCommandInstances(const std::shared_ptr<Model>& model);
 	static void InitDrawCommandBuffer();
@@ -72,7 +73,6 @@ private:
 	static void Flush();
 	static void NextBatch();
 	static void LoadShaders();
-	static void DrawPhysicsDebug();
 	static void DrawDebugVisualizations();
 	static void DrawDebug2D();
 	static void UpdateModelFrustumCulling();
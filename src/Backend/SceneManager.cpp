@@ -7,6 +7,7 @@
 #include "LightManager.h"
 #include "Logger.h"
 #include "ParticleRenderer.h"
+#include "Timer.hpp"
 #include "../Input/UserInput.h"
 #include <algorithm>
 #include <fstream>
@@ -22,6 +23,8 @@
 namespace
 {
   constexpr const char* SceneFilePath = "../res/scenes/scene.json";
+  // Main-thread time spent on loading steps per frame.
+  constexpr float LoadingFrameBudgetMs = 8.0f;
 
   const char* LightTypeName(LightType type)
   {
@@ -104,34 +107,41 @@ void Scene::StartLoading()
   m_Assets.loadingStarted = true;
   m_Assets.loadingDone = false;
 
-  for(auto& s : m_Assets.sounds) AudioManager::LoadSound(s.c_str());
+  for(auto& s : m_Assets.sounds) m_Assets.soundJobs.push_back(AudioManager::LoadSoundAsync(s));
 
   for(auto& m : m_Assets.music) AudioManager::LoadMusic(m.c_str());
 
   for(const auto& model : m_Assets.static_models)
   {
     m_Assets.futureStatic.push_back(
-        std::async(std::launch::async,
-            Model::CreateSTATIC,
-            model.path.c_str(),
-            model.scale,
-            model.flag,
-            model.meshType));
+        JobSystem::Async([model]()
+        {
+            // Cook collision on the worker right after import, so baking on
+            // the main thread only has to create the PhysX shapes.
+            auto result = Model::CreateSTATIC(model.path.c_str(), model.scale, model.flag, model.meshType);
+            result->SetMergeCollision(model.mergeCollision);
+            result->SetConvexProxy(model.convexProxy);
+            result->CookCollision();
+            return result;
+        }));
   }
 
   for(const auto& model : m_Assets.animated_models)
   {
     m_Assets.futureAnim.push_back(
-        std::async(std::launch::async,
-            Model::CreateANIMATED,
-            model.path.c_str(),
-            model.scale,
-            model.flag,
-            model.meshType));
+        JobSystem::Async([model]()
+        {
+            auto result = Model::CreateANIMATED(model.path.c_str(), model.scale, model.flag, model.meshType);
+            result->SetMergeCollision(model.mergeCollision);
+            result->CookCollision();
+            if (model.animationBakeRate > 0.0f)
+              result->BakeAnimationPoses(model.animationBakeRate);
+            return result;
+        }));
   }
 
   m_Assets.futureTextures.push_back(
-      std::async(std::launch::async,[skybox=m_Assets.skybox]()
+      JobSystem::Async([skybox=m_Assets.skybox]()
       {
           return Texture::CreateCUBEMAP(skybox);
       }));
@@ -581,103 +591,151 @@ void Scene::UpdateLoading()
 {
   if(!m_Assets.loadingStarted || m_Assets.loadingDone) return;
 
-  auto ready = [](auto& vec)
+  // Run steps until the frame budget is spent or a step has to wait for a
+  // worker; the loading screen keeps animating either way.
+  Timer frameTimer;
+  while (frameTimer.ElapsedMillis() < LoadingFrameBudgetMs)
   {
-    return std::all_of(vec.begin(),vec.end(),
-    [](auto& f)
-    {
-        return f.wait_for(std::chrono::seconds(0))
-            == std::future_status::ready;
-    });
-  };
+    if (!AdvanceLoading())
+      break;
+  }
+}
 
-  if(!ready(m_Assets.futureStatic) ||
-     !ready(m_Assets.futureAnim) ||
-     !ready(m_Assets.futureTextures))
-      return;
+bool Scene::AdvanceLoading()
+{
+  using Stage = SceneAssets::Stage;
 
-  if(!m_Assets.uploadStarted)
+  switch (m_Assets.stage)
   {
-    m_Assets.uploadStarted = true;
-
-    for(size_t i=0;i<m_Assets.static_models.size();i++)
+  case Stage::BakeModels:
+  {
+    // Models are baked in scene order (that order fixes their draw command
+    // and SSBO slots), each as soon as its own import has finished.
+    if (!m_Assets.bake)
     {
-        auto model = m_Assets.futureStatic[i].get();
-        model->SetCullingBoundsScale(m_Assets.static_models[i].cullingBoundsScale);
-        ModelManager::BakeModel(
-            m_Assets.static_models[i].path,
-            model);
+      const size_t staticCount = m_Assets.static_models.size();
+      if (m_Assets.bakeIndex == staticCount + m_Assets.animated_models.size())
+      {
+        m_Assets.stage = Stage::Skybox;
+        return true;
+      }
+
+      const bool isStatic = m_Assets.bakeIndex < staticCount;
+      auto& future = isStatic ? m_Assets.futureStatic[m_Assets.bakeIndex] : m_Assets.futureAnim[m_Assets.bakeIndex - staticCount];
+      if (!future.IsReady())
+        return false;
+
+      const auto& desc = isStatic ? m_Assets.static_models[m_Assets.bakeIndex] : m_Assets.animated_models[m_Assets.bakeIndex - staticCount];
+      auto model = future.Get();
+      model->SetCullingBoundsScale(desc.cullingBoundsScale);
+      m_Assets.bake.emplace(desc.path, model);
     }
 
-    for(size_t i=0;i<m_Assets.animated_models.size();i++)
+    if (m_Assets.bake->Step())
     {
-        auto model = m_Assets.futureAnim[i].get();
-        model->SetCullingBoundsScale(m_Assets.animated_models[i].cullingBoundsScale);
-        ModelManager::BakeModel(
-            m_Assets.animated_models[i].path,
-            model);
+      m_Assets.bake.reset();
+      ++m_Assets.bakeIndex;
     }
+    return true;
+  }
+  case Stage::Skybox:
+  {
+    const bool texturesReady = std::ranges::all_of(m_Assets.futureTextures, [](const auto& future) { return future.IsReady(); });
+    if (!texturesReady || !JobSystem::IsComplete(m_Assets.soundJobs))
+      return false;
 
-    auto skyboxTex = m_Assets.futureTextures[0].get();
-
-    Renderer::BakeSkyboxTextures("night",skyboxTex);
-
+    Renderer::BakeSkyboxTextures("night", m_Assets.futureTextures[0].Get());
+    m_Assets.stage = Stage::SpawnEntities;
+    return true;
+  }
+  case Stage::SpawnEntities:
     SpawnEntities();
+    m_Assets.stage = Stage::SpawnLights;
+    return true;
+  case Stage::SpawnLights:
     SpawnLights();
-
-    ModelManager::UploadToGPU();
+    m_Assets.stage = Stage::UploadGeometry;
+    return true;
+  case Stage::UploadGeometry:
+    ModelManager::UploadGeometry();
+    m_Assets.stage = Stage::CreateStorageBuffers;
+    return true;
+  case Stage::CreateStorageBuffers:
+    ModelManager::CreateStorageBuffers();
+    m_Assets.stage = Stage::InitDrawCommands;
+    return true;
+  case Stage::InitDrawCommands:
     Renderer::InitDrawCommandBuffer();
-
+    m_Assets.stage = Stage::Start;
+    return true;
+  case Stage::Start:
     m_Assets.futureStatic.clear();
     m_Assets.futureAnim.clear();
     m_Assets.futureTextures.clear();
+    m_Assets.soundJobs.clear();
 
     OnSceneStart();
 
     m_Assets.loadingDone = true;
     m_Assets.loadingStarted = false;
-    m_Assets.uploadStarted = false;
+    m_Assets.stage = Stage::BakeModels;
+    m_Assets.bakeIndex = 0;
+    return false;
   }
-}
 
-bool Scene::IsLoadingComplete() const
-{
-  return m_Assets.loadingDone;
+  return false;
 }
 
-void Scene::LoadSceneFromJSON(const std::string& path, const std::string& sceneName)
+float Scene::GetLoadingProgress() const
 {
-    std::ifstream file(path);
-    json data;
-    file >> data;
+  if (m_Assets.loadingDone)
+    return 1.0f;
 
-    auto& scene = data["scenes"][sceneName];
+  // Imports and bakes weigh one unit per model, every later stage one unit.
+  const size_t modelCount = m_Assets.static_models.size() + m_Assets.animated_models.size();
+  const size_t tailSteps = static_cast<size_t>(SceneAssets::Stage::Start);
+  const auto readyCount = [](const auto& futures)
+  {
+    return std::ranges::count_if(futures, [](const auto& future) { return future.IsReady(); });
+  };
 
-    if(scene.contains("sounds"))
-        m_Assets.sounds = scene["sounds"].get<std::vector<std::string>>();
+  float done = static_cast<float>(readyCount(m_Assets.futureStatic) + readyCount(m_Assets.futureAnim));
+  done += static_cast<float>(m_Assets.bakeIndex) + (m_Assets.bake ? m_Assets.bake->GetProgress() : 0.0f);
+  done += static_cast<float>(m_Assets.stage) - static_cast<float>(SceneAssets::Stage::BakeModels);
 
-    if(scene.contains("music"))
-        m_Assets.music = scene["music"].get<std::vector<std::string>>();
+  const float total = static_cast<float>(modelCount * 2 + tailSteps);
+  return total > 0.0f ? std::clamp(done / total, 0.0f, 1.0f) : 0.0f;
+}
 
-    if(scene.contains("skybox"))
-        m_Assets.skybox = scene["skybox"].get<std::vector<std::string>>();
+bool Scene::IsLoadingComplete() const
+{
+  return m_Assets.loadingDone;
+}
 
+void Scene::ReadModelDescs(const json& scene, std::vector<SceneModelDesc>& staticModels,
+  std::vector<SceneModelDesc>& animatedModels)
+{
     if(scene.contains("static_models"))
     {
         for(auto& m : scene["static_models"])
         {
-            SceneAssets::ModelDesc desc;
+            SceneModelDesc desc;
 
             desc.path = m["path"];
             desc.scale = m.value("scale",1.0f);
             desc.cullingBoundsScale = std::max(0.01f, m.value("culling_bounds_scale", 1.0f));
+            desc.mergeCollision = m.value("merge_collision", false);
             desc.flag = false;
 
             if(std::string mesh = m.value("mesh","none"); mesh == "trianglemesh") desc.meshType = MeshType::TRIANGLEMESH;
             else if(mesh == "convex")  desc.meshType = MeshType::CONVEXMESH;
             else desc.meshType = MeshType::NONE;
 
-            m_Assets.static_models.push_back(desc);
+            // Stand-in for a hand-authored "<name>_convex" helper: the model
+            // cooks a few vertex-limited hulls from its own meshes.
+            desc.convexProxy = desc.meshType == MeshType::NONE && m.value("convex_proxy", false);
+
+            staticModels.push_back(desc);
         }
     }
 
@@ -685,17 +743,38 @@ void Scene::LoadSceneFromJSON(const std::string& path, const std::string& sceneN
     {
         for(auto& m : scene["animated_models"])
         {
-            SceneAssets::ModelDesc desc;
+            SceneModelDesc desc;
 
             desc.path = m["path"];
             desc.scale = m.value("scale",1.0f);
             desc.cullingBoundsScale = std::max(0.01f, m.value("culling_bounds_scale", 1.0f));
+            desc.animationBakeRate = std::max(0.0f, m.value("animation_bake_rate", 0.0f));
             desc.flag = false;
             desc.meshType = MeshType::CONTROLLER;
 
-            m_Assets.animated_models.push_back(desc);
+            animatedModels.push_back(desc);
         }
     }
+}
+
+void Scene::LoadSceneFromJSON(const std::string& path, const std::string& sceneName)
+{
+    std::ifstream file(path);
+    json data;
+    file >> data;
+
+    auto& scene = data["scenes"][sceneName];
+
+    if(scene.contains("sounds"))
+        m_Assets.sounds = scene["sounds"].get<std::vector<std::string>>();
+
+    if(scene.contains("music"))
+        m_Assets.music = scene["music"].get<std::vector<std::string>>();
+
+    if(scene.contains("skybox"))
+        m_Assets.skybox = scene["skybox"].get<std::vector<std::string>>();
+
+    ReadModelDescs(scene, m_Assets.static_models, m_Assets.animated_models);
 
     if(scene.contains("entities"))
         m_Assets.entities = scene["entities"];
@@ -792,7 +871,7 @@ void SceneManager::Update(DeltaTime& dt)
   {
     s_PendingScene->UpdateLoading();
 
-    Renderer::DrawLoadingScreen();
+    Renderer::DrawLoadingScreen(s_PendingScene->GetLoadingProgress());
 
     if (s_PendingScene->IsLoadingComplete())
     {
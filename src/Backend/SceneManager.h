@@ -2,13 +2,15 @@
 
 #include "../input/Event.h"
 #include "../input/KeyEvent.h"
-#include <future>
 
 #include "ModelManager.h"
 #include "LightManager.h"
+#include "JobSystem.h"
 
 #include "json.hpp"
 
+#include <optional>
+
 using json = nlohmann::json;
 
 struct SceneEntity
@@ -38,10 +40,28 @@ struct SceneLight
   glm::vec3 rotation = glm::vec3(0.0f, -1.0f, 0.0f);
 };
 
+// One static or animated model entry of a scene in scene.json.
+struct SceneModelDesc
+{
+  std::string path;
+  float scale;
+  bool flag;
+  MeshType meshType;
+  float cullingBoundsScale = 1.0f;
+  bool mergeCollision = false; // one cooked triangle mesh per model
+  bool convexProxy = false;    // rendered model on its own convex proxy hull actor
+  float animationBakeRate = 0.0f; // baked pose cache frames per second, 0 samples clips live
+};
+
 struct Scene
 {
   Scene(const std::string& name) : m_Name(name) {}
 
+  // Model entries of one scene object from scene.json. Shared with the
+  // offline bake tool.
+  static void ReadModelDescs(const json& scene, std::vector<SceneModelDesc>& staticModels,
+    std::vector<SceneModelDesc>& animatedModels);
+
   virtual ~Scene() = default;
 
   virtual void OnUpdate(DeltaTime& dt) = 0;
@@ -51,6 +71,7 @@ struct Scene
   void StartLoading();
   void UpdateLoading();
   bool IsLoadingComplete() const;
+  float GetLoadingProgress() const;
   bool SaveToJSON(const std::string& path) const;
   uint64_t DuplicateEntity(uint64_t entityId);
   uint64_t AddModelEntity(const std::string& modelName);
@@ -76,6 +97,7 @@ private:
   bool OnMouseButtonPressed(MouseButtonPressedEvent& e);
 
   void LoadSceneFromJSON(const std::string& path, const std::string& sceneName);
+  bool AdvanceLoading();
   void SpawnEntities();
   void SpawnLights();
 
@@ -84,29 +106,38 @@ private:
     std::vector<std::string> sounds;
     std::vector<std::string> music;
 
-    struct ModelDesc
-    {
-        std::string path;
-        float scale;
-        bool flag;
-        MeshType meshType;
-        float cullingBoundsScale = 1.0f;
-    };
-
-    std::vector<ModelDesc> static_models;
-    std::vector<ModelDesc> animated_models;
+    std::vector<SceneModelDesc> static_models;
+    std::vector<SceneModelDesc> animated_models;
 
     std::vector<std::string> skybox;
 
-    std::vector<std::future<std::shared_ptr<Model>>> futureStatic;
-    std::vector<std::future<std::shared_ptr<Model>>> futureAnim;
-    std::vector<std::future<std::shared_ptr<Texture>>> futureTextures;
+    std::vector<JobFuture<std::shared_ptr<Model>>> futureStatic;
+    std::vector<JobFuture<std::shared_ptr<Model>>> futureAnim;
+    std::vector<JobFuture<std::shared_ptr<Texture>>> futureTextures;
+    std::vector<JobHandle> soundJobs;
 
     json entities;
     json lights = json::array();
 
+    // Main-thread half of loading, advanced one step at a time under a
+    // per-frame budget while model imports still run on the workers.
+    enum class Stage
+    {
+      BakeModels,
+      Skybox,
+      SpawnEntities,
+      SpawnLights,
+      UploadGeometry,
+      CreateStorageBuffers,
+      InitDrawCommands,
+      Start
+    };
+
+    Stage stage = Stage::BakeModels;
+    size_t bakeIndex = 0;
+    std::optional<ModelBake> bake;
+
     bool loadingStarted = false;
-    bool uploadStarted = false;
     bool loadingDone = false;
   };
 
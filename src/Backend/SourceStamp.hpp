@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Identity of a source asset as seen by the on-disk caches: a cache entry is
+// only valid while path, size and mtime all still match.
+struct SourceStamp
+{
+  std::string path;
+  uint64_t size = 0;
+  int64_t mtime = 0;
+
+  static bool Get(const std::string& sourcePath, SourceStamp& stamp)
+  {
+    std::error_code ec;
+    const auto absolute = std::filesystem::weakly_canonical(sourcePath, ec);
+    stamp.path = ec ? sourcePath : absolute.generic_string();
+
+    stamp.size = std::filesystem::file_size(sourcePath, ec);
+    if (ec) return false;
+
+    const auto time = std::filesystem::last_write_time(sourcePath, ec);
+    if (ec) return false;
+    stamp.mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+  }
+};
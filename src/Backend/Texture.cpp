@@ -1,7 +1,10 @@
 #include "Texture.h"
 #include "Logger.h"
 #include "Timer.hpp"
+#include "JobSystem.h"
+#include "TextureCache.h"
 #include <stb_image.h>
+#include <utility>
 
 namespace Utils {
 
@@ -46,39 +49,161 @@ Texture::Texture(const TextureSpecification& specification)
 	glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 }
 
-Texture::Texture(const std::string& path) : m_Path(path)
+DecodedImage& DecodedImage::operator=(DecodedImage&& other) noexcept
 {
-  Timer timer;
+  if (this != &other)
+  {
+    Reset();
+    Pixels = std::exchange(other.Pixels, nullptr);
+    Width = std::exchange(other.Width, 0);
+    Height = std::exchange(other.Height, 0);
+    Channels = std::exchange(other.Channels, 0);
+    m_FromStb = other.m_FromStb;
+  }
+  return *this;
+}
 
-  int width, height, channels;
-  stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+DecodedImage DecodedImage::Allocate(int width, int height, int channels)
+{
+  DecodedImage image;
+  image.Pixels = new uint8_t[static_cast<size_t>(width) * height * channels];
+  image.Width = width;
+  image.Height = height;
+  image.Channels = channels;
+  image.m_FromStb = false;
+  return image;
+}
 
-  if (data)
+void DecodedImage::Reset()
+{
+  if (Pixels)
   {
-      FlipImageVertically(data, width, height, channels);
-      m_RawData = new uint8_t[width * height * channels];
-      memcpy(m_RawData, data, width * height * channels);
-      m_IsLoaded = true;
+    if (m_FromStb) stbi_image_free(Pixels);
+    else delete[] Pixels;
+  }
+  Pixels = nullptr;
+  Width = Height = Channels = 0;
+  m_FromStb = true;
+}
 
-      m_Width = width;
-      m_Height = height;
+DecodedImage Texture::Decode(const std::string& path, const ImageDecodeOptions& options)
+{
+  DecodedImage image;
+  stbi_set_flip_vertically_on_load_thread(options.FlipVertically);
+  image.Pixels = stbi_load(path.c_str(), &image.Width, &image.Height, &image.Channels, options.DesiredChannels);
+  if (image.Pixels && options.DesiredChannels != 0)
+    image.Channels = options.DesiredChannels;
+  return image;
+}
 
-      GLenum internalFormat = 0, dataFormat = 0;
-      if (channels == 4)
-      {
-          internalFormat = GL_RGBA8;
-          dataFormat = GL_RGBA;
-      }
-      else if (channels == 3)
-      {
-          internalFormat = GL_RGB8;
-          dataFormat = GL_RGB;
-      }
+DecodedImage Texture::Decode(const uint8_t* data, size_t size, const ImageDecodeOptions& options)
+{
+  DecodedImage image;
+  stbi_set_flip_vertically_on_load_thread(options.FlipVertically);
+  image.Pixels = stbi_load_from_memory(data, static_cast<int>(size), &image.Width, &image.Height, &image.Channels, options.DesiredChannels);
+  if (image.Pixels && options.DesiredChannels != 0)
+    image.Channels = options.DesiredChannels;
+  return image;
+}
+
+void Texture::SetImage(DecodedImage&& image)
+{
+  m_Width = image.Width;
+  m_Height = image.Height;
+
+  GLenum internalFormat = 0, dataFormat = 0;
+  if (image.Channels == 4)
+  {
+      internalFormat = GL_RGBA8;
+      dataFormat = GL_RGBA;
+  }
+  else if (image.Channels == 3)
+  {
+      internalFormat = GL_RGB8;
+      dataFormat = GL_RGB;
+  }
+  else if (image.Channels == 1)
+  {
+      internalFormat = GL_R8;
+      dataFormat = GL_RED;
+  }
+
+  m_InternalFormat = internalFormat;
+  m_DataFormat = dataFormat;
+  m_Image = std::move(image);
+  m_IsLoaded = true;
+}
+
+void Texture::SetCompressedImage(CompressedImage&& image)
+{
+  m_Width = image.GetWidth();
+  m_Height = image.GetHeight();
+  m_InternalFormat = TextureCompressor::GetGLInternalFormat(image.Format);
+  m_DataFormat = m_InternalFormat;
+  m_Compressed = std::move(image);
+  m_IsLoaded = true;
+}
+
+bool Texture::DecodePendingCompressed()
+{
+  const bool isNormalMap = m_Type == "texture_normal";
+
+  CompressedImage compressed;
+  if (!TextureCache::Load(m_PendingFile, isNormalMap, compressed))
+  {
+    DecodedImage image = Decode(m_PendingFile, { .FlipVertically = true, .DesiredChannels = 4 });
+    if (!image.IsValid())
+      return false;
+
+    compressed = TextureCompressor::Compress(image, TextureCompressor::ChooseFormat(image, isNormalMap));
+    if (!compressed.IsValid())
+    {
+      SetImage(std::move(image));
+      return true;
+    }
+    TextureCache::Save(m_PendingFile, isNormalMap, compressed);
+  }
+
+  SetCompressedImage(std::move(compressed));
+  return true;
+}
+
+// DecodePending must not wait on other jobs: this thread would help run them
+// while holding m_DecodeOnce, and one of them may be this same texture.
+bool Texture::DecodeOnce()
+{
+  std::call_once(m_DecodeOnce, [this]() { m_Decoded = DecodePending(); });
+  return m_Decoded;
+}
+
+bool Texture::DecodePending()
+{
+  if (!m_PendingFile.empty())
+  {
+    const bool decoded = DecodePendingCompressed();
+    m_PendingFile.clear();
+    return decoded;
+  }
+
+  DecodedImage image = Decode(m_PendingData, m_PendingSize, { .FlipVertically = true });
 
-      m_InternalFormat = internalFormat;
-      m_DataFormat = dataFormat;
+  m_PendingData = nullptr;
+  m_PendingSize = 0;
 
-      stbi_image_free(data);
+  if (!image.IsValid())
+    return false;
+
+  SetImage(std::move(image));
+  return true;
+}
+
+Texture::Texture(const std::string& path) : m_Path(path)
+{
+  Timer timer;
+
+  if (DecodedImage image = Decode(path, { .FlipVertically = true }); image.IsValid())
+  {
+      SetImage(std::move(image));
       GABGL_WARN("Texture loading took {0} ms", timer.ElapsedMillis());
   }
   else
@@ -91,40 +216,9 @@ Texture::Texture(const std::string& path, const std::string& directory) : m_Path
 {
   Timer timer;
 
-  std::string filename = directory + '/' + path;
-  int width, height, channels;
-  stbi_uc* data = stbi_load(filename.c_str(), &width, &height, &channels, 0);
-  if (data)
+  if (DecodedImage image = Decode(directory + '/' + path, { .FlipVertically = true }); image.IsValid())
   {
-      FlipImageVertically(data, width, height, channels);
-      m_RawData = new uint8_t[width * height * channels];
-      memcpy(m_RawData, data, width * height * channels);
-      m_IsLoaded = true;
-
-      m_Width = width;
-      m_Height = height;
-
-      GLenum internalFormat = 0, dataFormat = 0;
-      if (channels == 4)
-      {
-          internalFormat = GL_RGBA8;
-          dataFormat = GL_RGBA;
-      }
-      else if (channels == 3)
-      {
-          internalFormat = GL_RGB8;
-          dataFormat = GL_RGB;
-      }
-      else if (channels == 1)
-      {
-          internalFormat = GL_R8;
-          dataFormat = GL_RED;
-      }
-
-      m_InternalFormat = internalFormat;
-      m_DataFormat = dataFormat;
-
-      stbi_image_free(data);
+      SetImage(std::move(image));
       GABGL_WARN("Texture loading took {0} ms", timer.ElapsedMillis());
   }
   else
@@ -137,45 +231,11 @@ Texture::Texture(const aiTexture* paiTexture, const std::string& path) : paiText
 {
   if (paiTexture->mHeight == 0)
   {
-    int width, height, channels;
-    unsigned char* data = stbi_load_from_memory(reinterpret_cast<const unsigned char*>(paiTexture->pcData),paiTexture->mWidth, &width, &height, &channels, 0);
-
-    if (data)
-    {
-      FlipImageVertically(data, width, height, channels);
-      m_RawData = new uint8_t[width * height * channels];
-      memcpy(m_RawData, data, width * height * channels);
-      m_IsLoaded = true;
-
-      m_Width = width;
-      m_Height = height;
-
-      GLenum internalFormat = 0, dataFormat = 0;
-      if (channels == 4)
-      {
-          internalFormat = GL_RGBA8;
-          dataFormat = GL_RGBA;
-      }
-      else if (channels == 3)
-      {
-          internalFormat = GL_RGB8;
-          dataFormat = GL_RGB;
-      }
-      else if (channels == 1)
-      {
-          internalFormat = GL_R8;
-          dataFormat = GL_RED;
-      }
-
-      m_InternalFormat = internalFormat;
-      m_DataFormat = dataFormat;
-
-      stbi_image_free(data);
-    }
+    DecodedImage image = Decode(reinterpret_cast<const uint8_t*>(paiTexture->pcData), paiTexture->mWidth, { .FlipVertically = true });
+    if (image.IsValid())
+        SetImage(std::move(image));
     else
-    {
         GABGL_ERROR("Failed to load compressed embedded texture!");
-    }
   }
   else
   {
@@ -187,67 +247,83 @@ Texture::Texture(const aiTexture* paiTexture, const std::string& path) : paiText
   }
 }
 
+// Same layout rules as aiTexture: height == 0 means `data` is an encoded image
+// of `width` bytes, otherwise it holds width * height RGBA8 texels.
+Texture::Texture(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path) : m_Path(path)
+{
+  if (height == 0)
+  {
+    DecodedImage image = Decode(data, width, { .FlipVertically = true });
+    if (image.IsValid())
+        SetImage(std::move(image));
+    else
+        GABGL_ERROR("Failed to load compressed embedded texture!");
+  }
+  else
+  {
+    DecodedImage image = DecodedImage::Allocate(static_cast<int>(width), static_cast<int>(height), 4);
+    memcpy(image.Pixels, data, image.GetSize());
+    SetImage(std::move(image));
+  }
+}
+
 Texture::Texture(const std::vector<std::string>& faces)
 {
   Timer timer;
 
   GABGL_ASSERT(faces.size() == 6, "Cubemap must have exactly 6 faces!");
 
-  stbi_set_flip_vertically_on_load(false);
-  for (int i = 0; i < 6; ++i)
+  JobSystem::ParallelFor(m_Faces.size(), 1, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      m_Faces[i] = Decode(faces[i], { .FlipVertically = false });
+  });
+
+  for (size_t i = 0; i < m_Faces.size(); ++i)
   {
-      int w, h, c;
-      unsigned char* data = stbi_load(faces[i].c_str(), &w, &h, &c, 0);
-      if (!data)
+      DecodedImage& face = m_Faces[i];
+      if (!face.IsValid())
       {
           GABGL_ERROR("Failed to load cubemap face: {}", faces[i]);
           continue;
       }
-      if (i == 0)
+      if (channels == 0)
       {
-          m_Width = w;
-          m_Height = h;
-          channels = c;
+          m_Width = face.Width;
+          m_Height = face.Height;
+          channels = face.Channels;
       }
-      else if (w != m_Width || h != m_Height || c != channels)
+      else if (face.Width != static_cast<int>(m_Width) || face.Height != static_cast<int>(m_Height) || face.Channels != channels)
       {
-          stbi_image_free(data);
+          face.Reset();
           GABGL_ERROR("Cubemap face size or channels mismatch: {}", faces[i]);
-          continue;
       }
-
-      pixels[i] = data;
   }
-  stbi_set_flip_vertically_on_load(true);
   GABGL_WARN("Texture loading took {0} ms", timer.ElapsedMillis());
 }
 
 Texture::~Texture()
 {
+  MakeNonResident();
   if (m_OwnsTexture && m_RendererID != 0) glDeleteTextures(1, &m_RendererID);
-  delete[] m_RawData;
-  for (unsigned char*& face : pixels)
+}
+
+GLuint64 Texture::MakeResident()
+{
+  if (m_BindlessHandle == 0 && m_RendererID != 0)
   {
-    if (face) stbi_image_free(face);
-    face = nullptr;
+    m_BindlessHandle = glGetTextureHandleARB(m_RendererID);
+    glMakeTextureHandleResidentARB(m_BindlessHandle);
   }
+  return m_BindlessHandle;
 }
 
-void Texture::FlipImageVertically(unsigned char* data, int width, int height, int channels)
+void Texture::MakeNonResident()
 {
-  int stride = width * channels;
-  std::vector<unsigned char> row(stride); // temporary buffer for a row
-
-  for (int y = 0; y < height / 2; ++y)
-  {
-      unsigned char* rowTop = data + y * stride;
-      unsigned char* rowBottom = data + (height - y - 1) * stride;
+  if (m_BindlessHandle == 0) return;
 
-      // Swap the two rows
-      std::memcpy(row.data(), rowTop, stride);
-      std::memcpy(rowTop, rowBottom, stride);
-      std::memcpy(rowBottom, row.data(), stride);
-  }
+  glMakeTextureHandleNonResidentARB(m_BindlessHandle);
+  m_BindlessHandle = 0;
 }
 
 void Texture::SetData(void* data, uint32_t size) const
@@ -300,7 +376,73 @@ std::shared_ptr<Texture> Texture::CreateEMBEDDED(const aiTexture* paiTexture, co
 	return std::make_shared<Texture>(paiTexture,path);
 }
 
+std::shared_ptr<Texture> Texture::CreateEMBEDDED(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path)
+{
+	return std::make_shared<Texture>(data,width,height,path);
+}
+
 std::shared_ptr<Texture> Texture::CreateCUBEMAP(const std::vector<std::string>& faces)
 {
 	return std::make_shared<Texture>(faces);
 }
+
+std::shared_ptr<Texture> Texture::CreateDeferred(const std::string& filename, const std::string& directory)
+{
+  std::shared_ptr<Texture> texture(new Texture());
+  texture->m_Path = filename;
+  texture->m_PendingFile = directory + '/' + filename;
+  texture->m_DecodeDeferred = true;
+  return texture;
+}
+
+std::shared_ptr<Texture> Texture::CreateEMBEDDEDDeferred(const aiTexture* paiTexture, const std::string& path)
+{
+  // Raw texels need no decoding, only compressed blobs are worth deferring.
+  // Raw ones are copied so the texture outlives the importer's scene.
+  if (paiTexture->mHeight != 0)
+    return std::make_shared<Texture>(reinterpret_cast<const uint8_t*>(paiTexture->pcData), paiTexture->mWidth, paiTexture->mHeight, path);
+
+  std::shared_ptr<Texture> texture(new Texture());
+  texture->paiTexture = paiTexture;
+  texture->m_Path = path;
+  texture->m_PendingData = reinterpret_cast<const uint8_t*>(paiTexture->pcData);
+  texture->m_PendingSize = paiTexture->mWidth;
+  texture->m_DecodeDeferred = true;
+  return texture;
+}
+
+std::shared_ptr<Texture> Texture::CreateEMBEDDEDDeferred(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path)
+{
+  if (height != 0)
+    return std::make_shared<Texture>(data, width, height, path);
+
+  std::shared_ptr<Texture> texture(new Texture());
+  texture->m_Path = path;
+  texture->m_PendingData = data;
+  texture->m_PendingSize = width;
+  texture->m_DecodeDeferred = true;
+  return texture;
+}
+
+void Texture::DecodeAll(const std::vector<std::shared_ptr<Texture>>& textures)
+{
+  Timer timer;
+
+  std::vector<Texture*> pending;
+  pending.reserve(textures.size());
+  for (const auto& texture : textures)
+    if (texture && texture->m_DecodeDeferred)
+      pending.push_back(texture.get());
+
+  if (pending.empty())
+    return;
+
+  JobSystem::ParallelFor(pending.size(), 1, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      if (!pending[i]->DecodeOnce())
+        GABGL_ERROR("COUDLNT LOAD TEXTURE! {}", pending[i]->GetPath());
+  });
+
+  GABGL_WARN("Decoding {0} textures took {1} ms", pending.size(), timer.ElapsedMillis());
+}
@@ -5,7 +5,9 @@
 #include <glad/glad.h>
 #include <vector>
 #include <array>
+#include <mutex>
 #include <assimp/scene.h>
+#include "TextureCompressor.h"
 
 enum class ImageFormat
 {
@@ -24,6 +26,37 @@ struct TextureSpecification
 	bool GenerateMips = true;
 };
 
+struct ImageDecodeOptions
+{
+	bool FlipVertically = false;
+	int DesiredChannels = 0; // 0 = keep the source channel count
+};
+
+// Owning CPU-side image. Produced by Texture::Decode, which is safe to call
+// from any thread (flip state is per call, never process-global).
+struct DecodedImage
+{
+	DecodedImage() = default;
+	~DecodedImage() { Reset(); }
+	DecodedImage(DecodedImage&& other) noexcept { *this = std::move(other); }
+	DecodedImage& operator=(DecodedImage&& other) noexcept;
+	DecodedImage(const DecodedImage&) = delete;
+	DecodedImage& operator=(const DecodedImage&) = delete;
+
+	static DecodedImage Allocate(int width, int height, int channels);
+	void Reset();
+	inline bool IsValid() const { return Pixels != nullptr; }
+	inline size_t GetSize() const { return static_cast<size_t>(Width) * Height * Channels; }
+
+	uint8_t* Pixels = nullptr;
+	int Width = 0;
+	int Height = 0;
+	int Channels = 0;
+
+private:
+	bool m_FromStb = true;
+};
+
 struct Texture 
 {
 	Texture() = default;
@@ -31,6 +64,7 @@ struct Texture
 	explicit Texture(const std::string& path);
 	Texture(const std::string& filename, const std::string& directory);
 	Texture(const aiTexture* paiTexture, const std::string& path);
+	Texture(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path);
 	explicit Texture(const std::vector<std::string>& faces);
 	~Texture();
 
@@ -47,8 +81,10 @@ struct Texture
 	inline void SetRendererID(uint32_t id) { m_RendererID = id; }
 	inline uint32_t GetRendererID() const { return m_RendererID; }
 	inline uint32_t& GetRendererID() { return m_RendererID; }
-	inline const uint8_t* GetRawData() const { return m_RawData; }
-	inline void ClearRawData() { delete[] m_RawData; m_RawData = nullptr; }
+	inline const uint8_t* GetRawData() const { return m_Image.Pixels; }
+	inline void ClearRawData() { m_Image.Reset(); m_Compressed = {}; }
+	inline bool IsCompressed() const { return m_Compressed.IsValid(); }
+	inline const CompressedImage& GetCompressedImage() const { return m_Compressed; }
 	inline const std::string& GetPath() const { return m_Path; }
 	inline GLenum GetDataFormat() const { return m_DataFormat; }
 	inline GLenum GetInternalFormat() const { return m_InternalFormat; }
@@ -58,23 +94,48 @@ struct Texture
 	inline const aiTexture* GetEmbeddedTexture() const { return paiTexture; }
 	inline bool IsLoaded() const { return m_IsLoaded; }
 
+	// Bindless residency is reference-free: the first call fetches and makes
+	// the handle resident, later calls return it. Shared textures are made
+	// resident once no matter how many meshes use them.
+	GLuint64 MakeResident();
+	void MakeNonResident();
+	inline bool IsResident() const { return m_BindlessHandle != 0; }
+
 	static std::shared_ptr<Texture> Create(const TextureSpecification& specification);
 	static std::shared_ptr<Texture> Create(const std::string& path);
 	static std::shared_ptr<Texture> Create(const std::string& path, const std::string& directory);
 	static std::shared_ptr<Texture> CreateEMBEDDED(const aiTexture* paiTexture, const std::string& directory);
+	static std::shared_ptr<Texture> CreateEMBEDDED(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path);
 	static std::shared_ptr<Texture> CreateCUBEMAP(const std::vector<std::string>& faces);
 	static std::shared_ptr<Texture> WrapExisting(uint32_t rendererID);
 
-	inline std::array<unsigned char*, 6>& GetPixels() { return pixels; }
+	// Deferred variants only record where the pixels come from; DecodeAll()
+	// then decodes every pending texture of a batch in parallel. File-backed
+	// ones are block-compressed through the TextureCache on the way. A texture
+	// shared through the TextureRegistry may sit in several batches; it is
+	// decoded once and later batches wait for that decode.
+	static std::shared_ptr<Texture> CreateDeferred(const std::string& filename, const std::string& directory);
+	static std::shared_ptr<Texture> CreateEMBEDDEDDeferred(const aiTexture* paiTexture, const std::string& path);
+	static std::shared_ptr<Texture> CreateEMBEDDEDDeferred(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path);
+	static void DecodeAll(const std::vector<std::shared_ptr<Texture>>& textures);
+
+	inline std::array<DecodedImage, 6>& GetFaces() { return m_Faces; }
 	inline int32_t GetChannels() const { return channels; }
 
+	static DecodedImage Decode(const std::string& path, const ImageDecodeOptions& options = {});
+	static DecodedImage Decode(const uint8_t* data, size_t size, const ImageDecodeOptions& options = {});
+
 private:
 
-	void FlipImageVertically(unsigned char* data, int width, int height, int channels);
+	void SetImage(DecodedImage&& image);
+	bool DecodeOnce();
+	bool DecodePending();
+	bool DecodePendingCompressed();
+	void SetCompressedImage(CompressedImage&& image);
 
 	TextureSpecification m_Specification;
 
-	std::array<unsigned char*, 6> pixels{};
+	std::array<DecodedImage, 6> m_Faces;
 	int32_t channels = 0;
 
 	const aiTexture* paiTexture = nullptr;
@@ -87,7 +148,15 @@ private:
 	bool m_OwnsTexture = true;
 	uint32_t m_Width = 0, m_Height = 0;
 	uint32_t m_RendererID = 0;
-	uint8_t* m_RawData = nullptr;
+	DecodedImage m_Image;
+	CompressedImage m_Compressed;
+	std::string m_PendingFile;
+	const uint8_t* m_PendingData = nullptr;
+	size_t m_PendingSize = 0;
+	bool m_DecodeDeferred = false;
+	bool m_Decoded = false;
+	std::once_flag m_DecodeOnce;
+	GLuint64 m_BindlessHandle = 0;
 	GLenum m_InternalFormat = 0, m_DataFormat = 0;
 };
 
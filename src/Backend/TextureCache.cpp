@@ -0,0 +1,124 @@
+#include "TextureCache.h"
+#include "TextureCompressor.h"
+#include "BinaryStream.hpp"
+#include "MappedFile.h"
+#include "SourceStamp.hpp"
+#include "Logger.h"
+
+#include <filesystem>
+#include <format>
+
+namespace
+{
+  constexpr uint32_t TEXTURE_CACHE_MAGIC = 0x54424147; // "GABT"
+  constexpr uint32_t TEXTURE_CACHE_VERSION = 1;
+  constexpr const char* TEXTURE_CACHE_DIRECTORY = "../res/cache/textures";
+
+  std::filesystem::path GetCacheFile(const SourceStamp& stamp, bool isNormalMap)
+  {
+    const std::string key = std::format("{}|{}", stamp.path, isNormalMap);
+    const std::string stem = std::filesystem::path(stamp.path).stem().string();
+    return std::filesystem::path(TEXTURE_CACHE_DIRECTORY) / std::format("{}_{:016x}.gabtex", stem, std::hash<std::string>{}(key));
+  }
+}
+
+bool TextureCache::Load(const std::string& sourcePath, bool isNormalMap, CompressedImage& image)
+{
+  SourceStamp stamp;
+  if (!SourceStamp::Get(sourcePath, stamp))
+    return false;
+
+  const auto cacheFile = GetCacheFile(stamp, isNormalMap);
+  std::error_code ec;
+  if (!std::filesystem::exists(cacheFile, ec))
+    return false;
+
+  const MappedFile file(cacheFile);
+  if (!file.IsOpen())
+    return false;
+
+  BinaryReader reader(file.GetData(), file.GetSize());
+
+  uint32_t magic = 0, version = 0;
+  std::string cachedPath;
+  uint64_t cachedSize = 0;
+  int64_t cachedTime = 0;
+  uint8_t cachedNormalMap = 0;
+  CompressedFormat format = CompressedFormat::NONE;
+  uint32_t mipCount = 0;
+  reader.Read(magic);
+  reader.Read(version);
+  reader.ReadString(cachedPath);
+  reader.Read(cachedSize);
+  reader.Read(cachedTime);
+  reader.Read(cachedNormalMap);
+  reader.Read(format);
+  reader.Read(mipCount);
+
+  if (!reader.IsValid() || magic != TEXTURE_CACHE_MAGIC || version != TEXTURE_CACHE_VERSION ||
+      cachedPath != stamp.path || cachedSize != stamp.size || cachedTime != stamp.mtime ||
+      (cachedNormalMap != 0) != isNormalMap || TextureCompressor::GetBlockSize(format) == 0 ||
+      mipCount == 0 || mipCount > 32)
+  {
+    GABGL_TRACE("[TEXTURECACHE]: Stale entry for {}", sourcePath);
+    return false;
+  }
+
+  const uint32_t blockSize = TextureCompressor::GetBlockSize(format);
+  CompressedImage result;
+  result.Format = format;
+  result.Mips.resize(mipCount);
+  for (CompressedMip& mip : result.Mips)
+  {
+    reader.Read(mip.Width);
+    reader.Read(mip.Height);
+    const size_t expected = static_cast<size_t>((mip.Width + 3) / 4) * ((mip.Height + 3) / 4) * blockSize;
+    if (!reader.ReadVector(mip.Data) || mip.Width == 0 || mip.Height == 0 || mip.Data.size() != expected)
+    {
+      GABGL_WARN("[TEXTURECACHE]: Corrupt entry {}", cacheFile.string());
+      return false;
+    }
+  }
+
+  uint32_t endMagic = 0;
+  reader.Read(endMagic);
+  if (!reader.IsValid() || endMagic != TEXTURE_CACHE_MAGIC || !reader.IsAtEnd())
+  {
+    GABGL_WARN("[TEXTURECACHE]: Corrupt entry {}", cacheFile.string());
+    return false;
+  }
+
+  image = std::move(result);
+  return true;
+}
+
+void TextureCache::Save(const std::string& sourcePath, bool isNormalMap, const CompressedImage& image)
+{
+  if (!image.IsValid())
+    return;
+
+  SourceStamp stamp;
+  if (!SourceStamp::Get(sourcePath, stamp))
+    return;
+
+  BinaryWriter writer;
+  writer.Write(TEXTURE_CACHE_MAGIC);
+  writer.Write(TEXTURE_CACHE_VERSION);
+  writer.WriteString(stamp.path);
+  writer.Write(stamp.size);
+  writer.Write(stamp.mtime);
+  writer.Write(static_cast<uint8_t>(isNormalMap));
+  writer.Write(image.Format);
+  writer.Write(static_cast<uint32_t>(image.Mips.size()));
+  for (const CompressedMip& mip : image.Mips)
+  {
+    writer.Write(mip.Width);
+    writer.Write(mip.Height);
+    writer.WriteVector(mip.Data);
+  }
+  writer.Write(TEXTURE_CACHE_MAGIC);
+
+  const auto cacheFile = GetCacheFile(stamp, isNormalMap);
+  if (!writer.SaveToFile(cacheFile))
+    GABGL_WARN("[TEXTURECACHE]: Failed to write {}", cacheFile.string());
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+struct CompressedImage;
+
+// On-disk store of block-compressed mip chains for file-backed textures.
+// Entries are keyed by source path, source size/mtime and whether the image
+// is a normal map, so warm loads skip both image decoding and BCn encoding.
+struct TextureCache
+{
+  // Returns false on a miss or a stale/corrupt entry.
+  static bool Load(const std::string& sourcePath, bool isNormalMap, CompressedImage& image);
+  static void Save(const std::string& sourcePath, bool isNormalMap, const CompressedImage& image);
+};
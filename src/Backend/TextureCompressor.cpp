@@ -0,0 +1,417 @@
+#include "TextureCompressor.h"
+#include "Texture.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  constexpr int BLOCK_PIXELS = 16;
+
+  struct MipLevel
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> rgba;
+  };
+
+  MipLevel Downsample(const MipLevel& src, bool renormalize)
+  {
+    MipLevel dst;
+    dst.width = std::max(1u, src.width / 2);
+    dst.height = std::max(1u, src.height / 2);
+    dst.rgba.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+    for (uint32_t y = 0; y < dst.height; ++y)
+    {
+      const uint32_t y0 = std::min(y * 2, src.height - 1);
+      const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+      for (uint32_t x = 0; x < dst.width; ++x)
+      {
+        const uint32_t x0 = std::min(x * 2, src.width - 1);
+        const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+        const uint8_t* p00 = &src.rgba[(static_cast<size_t>(y0) * src.width + x0) * 4];
+        const uint8_t* p01 = &src.rgba[(static_cast<size_t>(y0) * src.width + x1) * 4];
+        const uint8_t* p10 = &src.rgba[(static_cast<size_t>(y1) * src.width + x0) * 4];
+        const uint8_t* p11 = &src.rgba[(static_cast<size_t>(y1) * src.width + x1) * 4];
+        uint8_t* out = &dst.rgba[(static_cast<size_t>(y) * dst.width + x) * 4];
+
+        for (int c = 0; c < 4; ++c)
+          out[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+
+        // Averaging shortens normals; push XY back onto the unit hemisphere.
+        if (renormalize)
+        {
+          const float nx = out[0] / 127.5f - 1.0f;
+          const float ny = out[1] / 127.5f - 1.0f;
+          const float nz = out[2] / 127.5f - 1.0f;
+          const float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+          if (length > 1e-4f)
+          {
+            out[0] = static_cast<uint8_t>(std::clamp((nx / length + 1.0f) * 127.5f + 0.5f, 0.0f, 255.0f));
+            out[1] = static_cast<uint8_t>(std::clamp((ny / length + 1.0f) * 127.5f + 0.5f, 0.0f, 255.0f));
+            out[2] = static_cast<uint8_t>(std::clamp((nz / length + 1.0f) * 127.5f + 0.5f, 0.0f, 255.0f));
+          }
+        }
+      }
+    }
+    return dst;
+  }
+
+  // Gathers a 4x4 block, clamping at the image edge for levels smaller than a block.
+  void FetchBlock(const MipLevel& level, uint32_t blockX, uint32_t blockY, uint8_t block[BLOCK_PIXELS * 4])
+  {
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+      const uint32_t sy = std::min(blockY * 4 + y, level.height - 1);
+      for (uint32_t x = 0; x < 4; ++x)
+      {
+        const uint32_t sx = std::min(blockX * 4 + x, level.width - 1);
+        std::memcpy(&block[(y * 4 + x) * 4], &level.rgba[(static_cast<size_t>(sy) * level.width + sx) * 4], 4);
+      }
+    }
+  }
+
+  // Principal axis of the block's colours over the first `Channels` channels,
+  // returned as the extreme points of the pixels projected onto that axis.
+  template<int Channels>
+  void FitEndpoints(const uint8_t block[BLOCK_PIXELS * 4], float lo[Channels], float hi[Channels])
+  {
+    float mean[Channels] = {};
+    for (int i = 0; i < BLOCK_PIXELS; ++i)
+      for (int c = 0; c < Channels; ++c)
+        mean[c] += block[i * 4 + c];
+    for (int c = 0; c < Channels; ++c)
+      mean[c] /= BLOCK_PIXELS;
+
+    float covariance[Channels][Channels] = {};
+    for (int i = 0; i < BLOCK_PIXELS; ++i)
+      for (int a = 0; a < Channels; ++a)
+        for (int b = 0; b < Channels; ++b)
+          covariance[a][b] += (block[i * 4 + a] - mean[a]) * (block[i * 4 + b] - mean[b]);
+
+    float axis[Channels];
+    for (int c = 0; c < Channels; ++c)
+      axis[c] = 1.0f;
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+      float next[Channels] = {};
+      for (int a = 0; a < Channels; ++a)
+        for (int b = 0; b < Channels; ++b)
+          next[a] += covariance[a][b] * axis[b];
+
+      float length = 0.0f;
+      for (int c = 0; c < Channels; ++c)
+        length += next[c] * next[c];
+      length = std::sqrt(length);
+      if (length < 1e-6f)
+        break;
+      for (int c = 0; c < Channels; ++c)
+        axis[c] = next[c] / length;
+    }
+
+    float minT = 0.0f, maxT = 0.0f;
+    for (int i = 0; i < BLOCK_PIXELS; ++i)
+    {
+      float t = 0.0f;
+      for (int c = 0; c < Channels; ++c)
+        t += (block[i * 4 + c] - mean[c]) * axis[c];
+      minT = std::min(minT, t);
+      maxT = std::max(maxT, t);
+    }
+
+    for (int c = 0; c < Channels; ++c)
+    {
+      lo[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+      hi[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+    }
+  }
+
+  template<int Channels>
+  uint8_t NearestIndex(const uint8_t* pixel, const uint8_t palette[][4], int paletteSize)
+  {
+    int best = 0;
+    int bestError = std::numeric_limits<int>::max();
+    for (int i = 0; i < paletteSize; ++i)
+    {
+      int error = 0;
+      for (int c = 0; c < Channels; ++c)
+      {
+        const int d = pixel[c] - palette[i][c];
+        error += d * d;
+      }
+      if (error < bestError)
+      {
+        bestError = error;
+        best = i;
+      }
+    }
+    return static_cast<uint8_t>(best);
+  }
+
+  uint16_t PackRGB565(const float rgb[3])
+  {
+    const auto r = static_cast<uint16_t>(std::lround(rgb[0] * 31.0f / 255.0f));
+    const auto g = static_cast<uint16_t>(std::lround(rgb[1] * 63.0f / 255.0f));
+    const auto b = static_cast<uint16_t>(std::lround(rgb[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+
+  void UnpackRGB565(uint16_t color, uint8_t rgb[4])
+  {
+    const uint8_t r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    rgb[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+    rgb[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+    rgb[3] = 255;
+  }
+
+  void EncodeBC1(const uint8_t block[BLOCK_PIXELS * 4], uint8_t* out)
+  {
+    float lo[3], hi[3];
+    FitEndpoints<3>(block, lo, hi);
+
+    uint16_t c0 = PackRGB565(hi);
+    uint16_t c1 = PackRGB565(lo);
+    if (c0 < c1)
+      std::swap(c0, c1);
+
+    uint32_t indices = 0;
+    // c0 == c1 selects the 3-colour mode, where index 0 is still c0.
+    if (c0 != c1)
+    {
+      uint8_t palette[4][4];
+      UnpackRGB565(c0, palette[0]);
+      UnpackRGB565(c1, palette[1]);
+      for (int c = 0; c < 3; ++c)
+      {
+        palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+        palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+      }
+
+      for (int i = 0; i < BLOCK_PIXELS; ++i)
+        indices |= static_cast<uint32_t>(NearestIndex<3>(&block[i * 4], palette, 4)) << (i * 2);
+    }
+
+    std::memcpy(out, &c0, 2);
+    std::memcpy(out + 2, &c1, 2);
+    std::memcpy(out + 4, &indices, 4);
+  }
+
+  // Single-channel BC4 block; BC5 is two of these back to back.
+  void EncodeBC4(const uint8_t block[BLOCK_PIXELS * 4], int channel, uint8_t* out)
+  {
+    uint8_t r0 = 0, r1 = 255;
+    for (int i = 0; i < BLOCK_PIXELS; ++i)
+    {
+      r0 = std::max(r0, block[i * 4 + channel]);
+      r1 = std::min(r1, block[i * 4 + channel]);
+    }
+
+    out[0] = r0;
+    out[1] = r1;
+    uint64_t indices = 0;
+    if (r0 != r1)
+    {
+      uint8_t palette[8][4] = {};
+      palette[0][0] = r0;
+      palette[1][0] = r1;
+      for (int i = 2; i < 8; ++i)
+        palette[i][0] = static_cast<uint8_t>(((8 - i) * r0 + (i - 1) * r1 + 3) / 7);
+
+      for (int i = 0; i < BLOCK_PIXELS; ++i)
+      {
+        const uint8_t value[4] = { block[i * 4 + channel], 0, 0, 0 };
+        indices |= static_cast<uint64_t>(NearestIndex<1>(value, palette, 8)) << (i * 3);
+      }
+    }
+    for (int i = 0; i < 6; ++i)
+      out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+  }
+
+  void EncodeBC5(const uint8_t block[BLOCK_PIXELS * 4], uint8_t* out)
+  {
+    EncodeBC4(block, 0, out);
+    EncodeBC4(block, 1, out + 8);
+  }
+
+  struct BitWriter
+  {
+    uint8_t* out;
+    uint32_t bit = 0;
+
+    void Write(uint32_t value, uint32_t count)
+    {
+      for (uint32_t i = 0; i < count; ++i, ++bit)
+        if (value & (1u << i))
+          out[bit >> 3] |= static_cast<uint8_t>(1u << (bit & 7));
+    }
+  };
+
+  // BC7 mode 6: one subset, 7-bit RGBA endpoints with a p-bit each, 4-bit indices.
+  void EncodeBC7(const uint8_t block[BLOCK_PIXELS * 4], uint8_t* out)
+  {
+    static constexpr int WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    float lo[4], hi[4];
+    FitEndpoints<4>(block, lo, hi);
+
+    uint8_t quantized[2][4];
+    uint8_t pbits[2];
+    const float* targets[2] = { lo, hi };
+    for (int e = 0; e < 2; ++e)
+    {
+      float bestError = std::numeric_limits<float>::max();
+      for (uint8_t p = 0; p < 2; ++p)
+      {
+        uint8_t q[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c)
+        {
+          q[c] = static_cast<uint8_t>(std::clamp<long>(std::lround((targets[e][c] - p) * 0.5f), 0, 127));
+          const float d = targets[e][c] - ((q[c] << 1) | p);
+          error += d * d;
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          pbits[e] = p;
+          std::memcpy(quantized[e], q, 4);
+        }
+      }
+    }
+
+    uint8_t palette[16][4];
+    for (int i = 0; i < 16; ++i)
+      for (int c = 0; c < 4; ++c)
+      {
+        const int e0 = (quantized[0][c] << 1) | pbits[0];
+        const int e1 = (quantized[1][c] << 1) | pbits[1];
+        palette[i][c] = static_cast<uint8_t>(((64 - WEIGHTS[i]) * e0 + WEIGHTS[i] * e1 + 32) >> 6);
+      }
+
+    uint8_t indices[BLOCK_PIXELS];
+    for (int i = 0; i < BLOCK_PIXELS; ++i)
+      indices[i] = NearestIndex<4>(&block[i * 4], palette, 16);
+
+    // The anchor index only stores 3 bits, so its top bit must be zero.
+    if (indices[0] & 8)
+    {
+      std::swap(quantized[0], quantized[1]);
+      std::swap(pbits[0], pbits[1]);
+      for (uint8_t& index : indices)
+        index = static_cast<uint8_t>(15 - index);
+    }
+
+    std::memset(out, 0, 16);
+    BitWriter writer{ out };
+    writer.Write(1u << 6, 7);
+    for (int c = 0; c < 4; ++c)
+    {
+      writer.Write(quantized[0][c], 7);
+      writer.Write(quantized[1][c], 7);
+    }
+    writer.Write(pbits[0], 1);
+    writer.Write(pbits[1], 1);
+    writer.Write(indices[0], 3);
+    for (int i = 1; i < BLOCK_PIXELS; ++i)
+      writer.Write(indices[i], 4);
+  }
+
+  void EncodeLevel(const MipLevel& level, CompressedFormat format, CompressedMip& mip)
+  {
+    const uint32_t blocksX = (level.width + 3) / 4;
+    const uint32_t blocksY = (level.height + 3) / 4;
+    const uint32_t blockSize = TextureCompressor::GetBlockSize(format);
+
+    mip.Width = level.width;
+    mip.Height = level.height;
+    mip.Data.resize(static_cast<size_t>(blocksX) * blocksY * blockSize);
+
+    // Serial on purpose: Compress runs inside a texture's decode once-flag,
+    // and DecodeAll already spreads textures across the workers.
+    uint8_t block[BLOCK_PIXELS * 4];
+    for (uint32_t by = 0; by < blocksY; ++by)
+    {
+      for (uint32_t bx = 0; bx < blocksX; ++bx)
+      {
+        FetchBlock(level, bx, by, block);
+        uint8_t* out = &mip.Data[(static_cast<size_t>(by) * blocksX + bx) * blockSize];
+        switch (format)
+        {
+          case CompressedFormat::BC1: EncodeBC1(block, out); break;
+          case CompressedFormat::BC5: EncodeBC5(block, out); break;
+          case CompressedFormat::BC7: EncodeBC7(block, out); break;
+          default: break;
+        }
+      }
+    }
+  }
+}
+
+size_t CompressedImage::GetSize() const
+{
+  size_t size = 0;
+  for (const CompressedMip& mip : Mips)
+    size += mip.Data.size();
+  return size;
+}
+
+CompressedFormat TextureCompressor::ChooseFormat(const DecodedImage& rgba, bool isNormalMap)
+{
+  if (isNormalMap)
+    return CompressedFormat::BC5;
+
+  const size_t pixelCount = static_cast<size_t>(rgba.Width) * rgba.Height;
+  for (size_t i = 0; i < pixelCount; ++i)
+    if (rgba.Pixels[i * 4 + 3] != 255)
+      return CompressedFormat::BC7;
+  return CompressedFormat::BC1;
+}
+
+CompressedImage TextureCompressor::Compress(const DecodedImage& rgba, CompressedFormat format)
+{
+  CompressedImage image;
+  if (!rgba.IsValid() || rgba.Channels != 4 || format == CompressedFormat::NONE)
+    return image;
+
+  MipLevel level;
+  level.width = static_cast<uint32_t>(rgba.Width);
+  level.height = static_cast<uint32_t>(rgba.Height);
+  level.rgba.assign(rgba.Pixels, rgba.Pixels + rgba.GetSize());
+
+  image.Format = format;
+  while (true)
+  {
+    EncodeLevel(level, format, image.Mips.emplace_back());
+    if (level.width == 1 && level.height == 1)
+      break;
+    level = Downsample(level, format == CompressedFormat::BC5);
+  }
+  return image;
+}
+
+uint32_t TextureCompressor::GetBlockSize(CompressedFormat format)
+{
+  switch (format)
+  {
+    case CompressedFormat::BC1: return 8;
+    case CompressedFormat::BC5: return 16;
+    case CompressedFormat::BC7: return 16;
+    default: return 0;
+  }
+}
+
+uint32_t TextureCompressor::GetGLInternalFormat(CompressedFormat format)
+{
+  switch (format)
+  {
+    case CompressedFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case CompressedFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+    case CompressedFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    default: return 0;
+  }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct DecodedImage;
+
+enum class CompressedFormat : uint8_t
+{
+  NONE = 0,
+  BC1 = 1, // opaque RGB, 8 bytes per 4x4 block
+  BC5 = 2, // two-channel normal maps (XY, Z reconstructed in the shader)
+  BC7 = 3  // RGBA, 16 bytes per 4x4 block
+};
+
+struct CompressedMip
+{
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  std::vector<uint8_t> Data;
+};
+
+// Full block-compressed mip chain of one texture, ready for
+// glCompressedTextureSubImage2D.
+struct CompressedImage
+{
+  CompressedFormat Format = CompressedFormat::NONE;
+  std::vector<CompressedMip> Mips;
+
+  inline bool IsValid() const { return Format != CompressedFormat::NONE && !Mips.empty(); }
+  inline uint32_t GetWidth() const { return Mips.empty() ? 0 : Mips[0].Width; }
+  inline uint32_t GetHeight() const { return Mips.empty() ? 0 : Mips[0].Height; }
+  size_t GetSize() const;
+};
+
+// CPU BCn encoder. Builds a box-filtered mip chain down to 1x1 and encodes
+// every level. BC7 only emits mode 6 (single subset RGBA), which keeps the
+// encoder simple while still handling alpha.
+struct TextureCompressor
+{
+  static CompressedFormat ChooseFormat(const DecodedImage& rgba, bool isNormalMap);
+  // `rgba` must hold 4 channels.
+  static CompressedImage Compress(const DecodedImage& rgba, CompressedFormat format);
+
+  static uint32_t GetBlockSize(CompressedFormat format);
+  static uint32_t GetGLInternalFormat(CompressedFormat format);
+};
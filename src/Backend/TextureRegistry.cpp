@@ -0,0 +1,78 @@
+#include "TextureRegistry.h"
+#include "Texture.h"
+#include "SourceStamp.hpp"
+
+#include <format>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+  struct TextureRegistryData
+  {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<Texture>> textures;
+  } s_Data;
+
+  template<typename F>
+  std::shared_ptr<Texture> Acquire(const std::string& key, const std::string& type, F&& create)
+  {
+    std::lock_guard lock(s_Data.mutex);
+
+    std::weak_ptr<Texture>& entry = s_Data.textures[key];
+    if (auto texture = entry.lock())
+      return texture;
+
+    // Deferred creation only records the source, so holding the lock is cheap.
+    std::shared_ptr<Texture> texture = create();
+    if (texture)
+      texture->SetType(type);
+    entry = texture;
+    return texture;
+  }
+
+  std::string EmbeddedKey(const uint8_t* data, uint64_t size, uint32_t width, uint32_t height, const std::string& type)
+  {
+    const size_t hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), size));
+    return std::format("embedded|{:016x}|{}|{}x{}|{}", hash, size, width, height, type);
+  }
+}
+
+std::shared_ptr<Texture> TextureRegistry::AcquireFile(const std::string& filename, const std::string& directory, const std::string& type)
+{
+  SourceStamp stamp;
+  if (!SourceStamp::Get(directory + '/' + filename, stamp))
+  {
+    // Missing files still get a Texture so the decode reports the error.
+    auto texture = Texture::CreateDeferred(filename, directory);
+    texture->SetType(type);
+    return texture;
+  }
+
+  const std::string key = std::format("file|{}|{}|{}|{}", stamp.path, stamp.size, stamp.mtime, type);
+  return Acquire(key, type, [&]() { return Texture::CreateDeferred(filename, directory); });
+}
+
+std::shared_ptr<Texture> TextureRegistry::AcquireEmbedded(const aiTexture* paiTexture, const std::string& path, const std::string& type)
+{
+  const uint64_t size = paiTexture->mHeight == 0
+    ? paiTexture->mWidth
+    : static_cast<uint64_t>(paiTexture->mWidth) * paiTexture->mHeight * 4;
+  const std::string key = EmbeddedKey(reinterpret_cast<const uint8_t*>(paiTexture->pcData), size, paiTexture->mWidth, paiTexture->mHeight, type);
+  return Acquire(key, type, [&]() { return Texture::CreateEMBEDDEDDeferred(paiTexture, path); });
+}
+
+std::shared_ptr<Texture> TextureRegistry::AcquireEmbedded(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path, const std::string& type)
+{
+  const uint64_t size = height == 0 ? width : static_cast<uint64_t>(width) * height * 4;
+  const std::string key = EmbeddedKey(data, size, width, height, type);
+  return Acquire(key, type, [&]() { return Texture::CreateEMBEDDEDDeferred(data, width, height, path); });
+}
+
+void TextureRegistry::Prune()
+{
+  std::lock_guard lock(s_Data.mutex);
+  std::erase_if(s_Data.textures, [](const auto& entry) { return entry.second.expired(); });
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct Texture;
+struct aiTexture;
+
+// Scene-wide table of model textures keyed by content: canonical path, size
+// and mtime for files, a hash of the bytes for embedded images, plus the
+// material slot (which picks the block format). Models that reference the
+// same image get one Texture, so it is decoded, uploaded and made resident
+// once. Entries are weak; a texture lives as long as some mesh holds it.
+// Safe to call from the model import jobs.
+struct TextureRegistry
+{
+  static std::shared_ptr<Texture> AcquireFile(const std::string& filename, const std::string& directory, const std::string& type);
+  static std::shared_ptr<Texture> AcquireEmbedded(const aiTexture* paiTexture, const std::string& path, const std::string& type);
+  static std::shared_ptr<Texture> AcquireEmbedded(const uint8_t* data, uint32_t width, uint32_t height, const std::string& path, const std::string& type);
+
+  // Drops expired entries; live textures are untouched.
+  static void Prune();
+};
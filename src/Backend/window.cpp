@@ -3,7 +3,7 @@
 #include "../input/EngineEvent.h"
 #include "../input/KeyEvent.h"
 #include "Logger.h"
-#include <stb_image.h>
+#include "Texture.h"
 #include "SceneManager.h"
 #include "Settings.h"
 
@@ -192,12 +192,13 @@ void Window::Update()
 
 void Window::SetWindowIcon(const char* iconpath, GLFWwindow* window)
 {
-  stbi_set_flip_vertically_on_load(0);
-  GLFWimage images[1];
-  images[0].pixels = stbi_load(iconpath, &images[0].width, &images[0].height, 0, 4);
-  if (images[0].pixels) {
+  DecodedImage icon = Texture::Decode(iconpath, { .FlipVertically = false, .DesiredChannels = 4 });
+  if (icon.IsValid()) {
+    GLFWimage images[1];
+    images[0].width = icon.Width;
+    images[0].height = icon.Height;
+    images[0].pixels = icon.Pixels;
     glfwSetWindowIcon(window, 1, images);
-    stbi_image_free(images[0].pixels);
   }
 }
 
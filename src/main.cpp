@@ -3,11 +3,13 @@
 #include "backend/AudioManager.h"
 #include "backend/LightManager.h"
 #include "backend/Renderer.h"
+#include "backend/Buffer.h"
 #include "backend/PhysX.h"
 #include "backend/FontManager.h"
 #include "backend/Settings.h"
 #include "backend/SceneManager.h"
 #include "backend/Window.h"
+#include "backend/JobSystem.h"
 
 #include <thread>
 #include <chrono>
@@ -21,6 +23,7 @@ extern "C" {
 int main()
 {
   Logger::Init();
+  JobSystem::Init();
   Settings::Init();
   Window::Init("GABGL", Settings::GetWindowWidth(), Settings::GetWindowHeight());
   AudioManager::Init();
@@ -43,8 +46,10 @@ int main()
 
     DeltaTime dt;
 
+    JobSystem::ProcessMainThreadQueue();
     SceneManager::Update(dt);
 
+    StagingRing::EndFrame();
     Window::Update();
 
     if (const uint32_t fpsLimit = Settings::GetFPSLimit(); !Settings::GetVSync() && fpsLimit > 0)
@@ -62,6 +67,7 @@ int main()
   Renderer::Shutdown();
   FontManager::Shutdown();
   PhysX::Shutdown();
+  JobSystem::Shutdown();
   Window::Terminate();
 
   return 0;
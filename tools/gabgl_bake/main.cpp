@@ -0,0 +1,306 @@
+// Offline asset baker. Imports every model and skybox referenced by
+// scene.json on all cores and leaves the runtime caches (../res/cache/models,
+// textures and physx) warm, so gl_engine never has to run Assimp, meshopt,
+// texture compression or PhysX cooking itself. No window or GL context is
+// created. Run it from the same directory as gl_engine, since asset paths
+// in scene.json are relative to it.
+//
+// --bench-animation skips the report and instead times bone key lookups on
+// the animated models' clips (the old linear scan against Bone's cursor
+// search, in order and under random seeks), whole-pose sampling (Bone's
+// per-bone matrices against AnimationSampler) and the size of the source
+// keys against the reduced, quantized tracks.
+//
+//   gabgl_bake [--bench-animation] [scene.json]
+
+#include "Backend/Logger.h"
+#include "Backend/JobSystem.h"
+#include "Backend/PhysX.h"
+#include "Backend/ModelManager.h"
+#include "Backend/SceneManager.h"
+#include "Backend/Texture.h"
+#include "Backend/Timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr const char* DefaultScenePath = "../res/scenes/scene.json";
+
+  struct BakeItem
+  {
+    std::string label;
+    SceneModelDesc model;
+    bool animated = false;
+    std::vector<std::string> skybox;
+  };
+
+  struct BakeResult
+  {
+    float millis = 0.0f;
+    size_t meshes = 0;
+    size_t textures = 0;
+    size_t collision = 0; // cooked PhysX streams
+    bool ok = false;
+  };
+
+  BakeResult BakeModel(const BakeItem& item)
+  {
+    Timer timer;
+    BakeResult result;
+
+    const SceneModelDesc& desc = item.model;
+    auto model = item.animated
+      ? Model::CreateANIMATED(desc.path.c_str(), desc.scale, desc.flag, desc.meshType)
+      : Model::CreateSTATIC(desc.path.c_str(), desc.scale, desc.flag, desc.meshType);
+
+    model->SetMergeCollision(desc.mergeCollision);
+    model->SetConvexProxy(desc.convexProxy);
+    model->CookCollision();
+
+    for (const Mesh& mesh : model->GetMeshes())
+      result.textures += mesh.m_Textures.size();
+    result.meshes = model->GetMeshes().size();
+    result.collision = model->m_CookedCollision.size();
+    result.ok = result.meshes > 0;
+    result.millis = timer.ElapsedMillis();
+    return result;
+  }
+
+  BakeResult BakeSkybox(const BakeItem& item)
+  {
+    Timer timer;
+    BakeResult result;
+
+    const auto cubemap = Texture::CreateCUBEMAP(item.skybox);
+    result.textures = item.skybox.size();
+    result.ok = cubemap && cubemap->GetWidth() > 0;
+    result.millis = timer.ElapsedMillis();
+    return result;
+  }
+
+  // Reference for the benchmark: what Bone did before it kept a cursor.
+  template<typename Key>
+  int LinearKeyIndex(const std::vector<Key>& keys, float time)
+  {
+    const int count = static_cast<int>(keys.size());
+    for (int i = 0; i + 1 < count; ++i)
+    {
+      if (time < keys[i + 1].timeStamp)
+        return i;
+    }
+    return std::max(count - 2, 0);
+  }
+
+  // Looks up all three tracks of every bone at each time in `times`, the way
+  // one model samples its pose once per frame. Returns ns per track lookup.
+  template<typename Lookup>
+  double TimeLookups(const std::vector<Bone>& bones, const std::vector<float>& times, Lookup&& lookup, int64_t& sink)
+  {
+    std::vector<Bone::Cursors> cursors(bones.size());
+    size_t lookups = 0;
+    Timer timer;
+    for (const float time : times)
+    {
+      for (size_t i = 0; i < bones.size(); ++i)
+      {
+        sink += lookup(bones[i].GetPositionKeys(), time, cursors[i].position);
+        sink += lookup(bones[i].GetRotationKeys(), time, cursors[i].rotation);
+        sink += lookup(bones[i].GetScaleKeys(), time, cursors[i].scale);
+        lookups += 3;
+      }
+    }
+    return lookups ? timer.Elapsed() * 1e9 / lookups : 0.0;
+  }
+
+  // Samples all tracks of the clip at each time in `times`. Returns us per pose.
+  double TimeBonePoses(const AnimationData& clip, const std::vector<float>& times, float& sink)
+  {
+    std::vector<Bone::Cursors> cursors(clip.bones.size());
+    Timer timer;
+    for (const float time : times)
+    {
+      for (size_t i = 0; i < clip.bones.size(); ++i)
+        sink += clip.bones[i].GetInterpolatedTransform(time, TransformTRS{}, cursors[i]).ToMat4()[3][0];
+    }
+    return times.empty() ? 0.0 : timer.Elapsed() * 1e6 / times.size();
+  }
+
+  double TimeSampledPoses(const AnimationData& clip, const std::vector<float>& times, float& sink)
+  {
+    std::vector<int32_t> cursors;
+    std::vector<AffineTransform> pose;
+    Timer timer;
+    for (const float time : times)
+    {
+      AnimationSampler::Sample(clip.tracks, time, cursors, pose);
+      sink += pose.empty() ? 0.0f : pose.back().rows[0].w;
+    }
+    return times.empty() ? 0.0 : timer.Elapsed() * 1e6 / times.size();
+  }
+
+  int BenchAnimation(const std::vector<BakeItem>& items)
+  {
+    constexpr float FrameRate = 60.0f;
+    constexpr int Loops = 8;
+
+    std::mt19937 engine(1234);
+    int64_t sink = 0;
+    float poseSink = 0.0f;
+
+    std::printf("%-32s %-20s %5s %7s %10s %10s %10s %8s %10s %10s %7s %9s %9s\n", "model", "clip", "bones", "keys",
+      "linear ns", "cursor ns", "seek ns", "speedup", "bone us", "sampler us", "packed", "source KB", "packed KB");
+    for (const BakeItem& item : items)
+    {
+      if (!item.animated)
+        continue;
+
+      const SceneModelDesc& desc = item.model;
+      const auto model = Model::CreateANIMATED(desc.path.c_str(), desc.scale, desc.flag, desc.meshType);
+      for (const AnimationData& clip : model->m_ProcessedAnimations)
+      {
+        // Frame times over a few loops in ticks, wrapped like UpdateAnimation.
+        std::vector<float> playback;
+        const float step = clip.ticksPerSecond / FrameRate;
+        for (float time = 0.0f; time < clip.duration * Loops; time += step)
+          playback.push_back(std::fmod(time, clip.duration));
+        std::vector<float> seeks = playback;
+        std::ranges::shuffle(seeks, engine);
+
+        size_t keys = 0;
+        for (const Bone& bone : clip.bones)
+          keys += bone.GetPositionKeys().size() + bone.GetRotationKeys().size() + bone.GetScaleKeys().size();
+
+        const auto linear = [](const auto& track, float time, int&) { return LinearKeyIndex(track, time); };
+        const auto cursor = [](const auto& track, float time, int& at) { return Bone::FindKeyIndex(track, time, at); };
+        const double linearNs = TimeLookups(clip.bones, playback, linear, sink);
+        const double cursorNs = TimeLookups(clip.bones, playback, cursor, sink);
+        const double seekNs = TimeLookups(clip.bones, seeks, cursor, sink);
+        const double boneUs = TimeBonePoses(clip, playback, poseSink);
+        const double samplerUs = TimeSampledPoses(clip, playback, poseSink);
+
+        std::printf("%-32s %-20s %5zu %7zu %10.1f %10.1f %10.1f %7.1fx %10.2f %10.2f %7zu %9.1f %9.1f\n",
+          desc.path.c_str(), clip.name.c_str(), clip.bones.size(), keys, linearNs, cursorNs, seekNs,
+          cursorNs > 0.0 ? linearNs / cursorNs : 0.0, boneUs, samplerUs, clip.tracks.GetKeyCount(),
+          clip.tracks.sourceSize / 1024.0, clip.tracks.GetSize() / 1024.0);
+      }
+    }
+    // Keeps the lookups from being optimized away.
+    return sink == -1 || poseSink == -1.0f ? 1 : 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Logger::Init();
+
+  bool benchAnimation = false;
+  std::string scenePath = DefaultScenePath;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::string(argv[i]) == "--bench-animation")
+      benchAnimation = true;
+    else
+      scenePath = argv[i];
+  }
+
+  std::ifstream file(scenePath);
+  if (!file)
+  {
+    std::fprintf(stderr, "gabgl_bake: cannot open '%s'\n", scenePath.c_str());
+    return 1;
+  }
+
+  json data;
+  try
+  {
+    file >> data;
+  }
+  catch (const json::exception& exception)
+  {
+    std::fprintf(stderr, "gabgl_bake: cannot parse '%s': %s\n", scenePath.c_str(), exception.what());
+    return 1;
+  }
+
+  // Scenes share assets; each distinct import is baked once.
+  std::vector<BakeItem> items;
+  std::set<std::string> seen;
+  const auto addModel = [&](const SceneModelDesc& desc, bool animated)
+  {
+    const std::string key = std::format("{}|{}|{}|{}|{}|{}", desc.path, desc.scale, static_cast<int>(desc.meshType),
+      desc.mergeCollision, desc.convexProxy, animated);
+    if (seen.insert(key).second)
+      items.push_back({ desc.path, desc, animated, {} });
+  };
+
+  const json scenes = data.value("scenes", json::object());
+  for (const auto& [sceneName, scene] : scenes.items())
+  {
+    std::vector<SceneModelDesc> staticModels, animatedModels;
+    Scene::ReadModelDescs(scene, staticModels, animatedModels);
+    for (const SceneModelDesc& desc : staticModels) addModel(desc, false);
+    for (const SceneModelDesc& desc : animatedModels) addModel(desc, true);
+
+    if (scene.contains("skybox"))
+    {
+      auto faces = scene["skybox"].get<std::vector<std::string>>();
+      if (faces.size() == 6 && seen.insert("skybox|" + faces.front()).second)
+        items.push_back({ "skybox " + sceneName, {}, false, std::move(faces) });
+    }
+  }
+
+  JobSystem::Init();
+  PhysX::Init();
+
+  if (benchAnimation)
+  {
+    const int status = BenchAnimation(items);
+    PhysX::Shutdown();
+    JobSystem::Shutdown();
+    return status;
+  }
+
+  Timer total;
+  std::vector<JobFuture<BakeResult>> jobs;
+  jobs.reserve(items.size());
+  for (const BakeItem& item : items)
+    jobs.push_back(JobSystem::Async([&item]() { return item.skybox.empty() ? BakeModel(item) : BakeSkybox(item); }));
+
+  std::vector<BakeResult> results;
+  results.reserve(jobs.size());
+  for (auto& job : jobs)
+    results.push_back(job.Get());
+  const float wallMillis = total.ElapsedMillis();
+
+  std::vector<size_t> order(items.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::ranges::sort(order, [&](size_t a, size_t b) { return results[a].millis > results[b].millis; });
+
+  float busyMillis = 0.0f;
+  size_t failed = 0;
+  std::printf("%10s  %6s  %8s  %9s  %s\n", "ms", "meshes", "textures", "collision", "asset");
+  for (const size_t i : order)
+  {
+    const BakeResult& result = results[i];
+    busyMillis += result.millis;
+    failed += result.ok ? 0 : 1;
+    std::printf("%10.1f  %6zu  %8zu  %9zu  %s%s\n", result.millis, result.meshes, result.textures, result.collision,
+      items[i].label.c_str(), result.ok ? "" : "  [FAILED]");
+  }
+  std::printf("\n%zu assets, %zu failed, %.1f ms wall, %.1f ms summed over %u workers\n",
+    items.size(), failed, wallMillis, busyMillis, JobSystem::GetWorkerCount());
+
+  results.clear();
+  jobs.clear();
+  PhysX::Shutdown();
+  JobSystem::Shutdown();
+  return failed == 0 ? 0 : 1;
+}